@@ -0,0 +1,160 @@
+// Idles a game for a few hours of frames three ways: without automation,
+// with the AutoBuyer, and with an autobuyer that scans every shop item with
+// canPurchase each frame and buys the cheapest until nothing is left. Both
+// autobuyers must end in the same state; the AutoBuyer should cost about as
+// much per frame as not buying at all, since a frame where nothing becomes
+// affordable costs it one comparison. Runs on the standard shop and on a
+// generated one with thousands of items.
+// Build: g++ -std=c++17 -O2 bench/AutoBuyBench.cpp core/GameCore.cpp core/ShopCatalog.cpp core/BigNumber.cpp core/Simulation.cpp core/MessageBoard.cpp core/AutoBuyer.cpp -o autobuybench
+// Usage: autobuybench [frames]
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+#include "../core/AutoBuyer.h"
+
+using namespace piegame;
+
+const float FRAME = 1.0f / 30.0f;
+
+// n buildings with costs spread over the run, each with a chain of two upgrades
+static std::string makeCatalog(int n) {
+    std::string text;
+    for (int i = 0; i < n; ++i) {
+        text += "building | B" + std::to_string(i) + " | " + std::to_string(10 + i * 37) + " | " +
+                std::to_string(1 + i % 13) + "\n";
+    }
+    for (int i = 0; i < n; ++i) {
+        std::string b = std::to_string(i);
+        text += "upgrade | U" + b + " | " + std::to_string(500 + i * 91) + " | 2 | B" + b + "\n";
+        text += "upgrade | V" + b + " | " + std::to_string(5000 + i * 97) + " | 1.5 | B" + b + " | U" + b + "\n";
+    }
+    return text;
+}
+
+// The per-frame scan: cheapest affordable candidate, ties to the earlier slot
+static int cheapestAffordable(const Simulation& sim, const AutoBuyPolicy& policy) {
+    int best = -1;
+    BigNumber bestCost;
+    for (int slot = 0; slot < (int)sim.shopItems.size(); ++slot) {
+        const ShopItem& item = *sim.shopItems[slot];
+        const CatalogEntry& entry = sim.catalog()[slot];
+        if (entry.kind == ShopKind::Building) {
+            if (!policy.buildings) continue;
+            const Building& b = static_cast<const Building&>(item);
+            if (policy.buildingLimit > 0 && b.getCount() >= policy.buildingLimit) continue;
+        } else {
+            if (!policy.upgrades) continue;
+            if (entry.prerequisite >= 0 &&
+                !static_cast<const Upgrade&>(*sim.shopItems[entry.prerequisite]).isPurchased()) {
+                continue;
+            }
+        }
+        if (!item.canPurchase(sim.game.totalPies - policy.reserve)) continue;
+        if (best < 0 || item.getCost() < bestCost) {
+            best = slot;
+            bestCost = item.getCost();
+        }
+    }
+    return best;
+}
+
+enum class Mode { Idle, AutoBuyer, Scan };
+
+struct Outcome {
+    double nsPerFrame;
+    double nsPerCheck = 0.0; // AutoBuyer::next() with nothing affordable
+    int actions = 0;
+    std::string state;
+};
+
+static Outcome idle(const ShopCatalog& catalog, Mode mode, const AutoBuyPolicy& policy, int frames) {
+    Simulation sim(catalog);
+    sim.skipIntro();
+    sim.game.totalPies = 500;
+    AutoBuyer buyer(policy);
+    Outcome out;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; ++f) {
+        sim.step(FRAME);
+        Action action;
+        if (mode == Mode::AutoBuyer) {
+            while (buyer.next(sim, action) && sim.apply(action)) out.actions++;
+        } else if (mode == Mode::Scan) {
+            int slot;
+            while ((slot = cheapestAffordable(sim, policy)) >= 0 && sim.apply({ ActionType::BuyItem, slot })) {
+                out.actions++;
+            }
+        }
+    }
+    out.nsPerFrame = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / frames;
+
+    if (mode == Mode::AutoBuyer) {
+        const int checks = 10000000;
+        Action action;
+        int found = 0;
+        start = std::chrono::steady_clock::now();
+        for (int c = 0; c < checks; ++c) found += buyer.next(sim, action);
+        out.nsPerCheck = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / checks;
+        out.actions += found;
+    }
+
+    std::ostringstream state;
+    state << "pies " << sim.game.totalPies << ", pps " << sim.game.piesPerSecond;
+    int owned = 0, upgrades = 0;
+    for (int slot = 0; slot < (int)sim.shopItems.size(); ++slot) {
+        if (catalog[slot].kind == ShopKind::Building) owned += static_cast<const Building&>(*sim.shopItems[slot]).getCount();
+        else upgrades += static_cast<const Upgrade&>(*sim.shopItems[slot]).isPurchased();
+    }
+    state << ", buildings " << owned << ", upgrades " << upgrades;
+    out.state = state.str();
+    return out;
+}
+
+int main(int argc, char** argv) {
+    int frames = argc > 1 ? atoi(argv[1]) : 30 * 3600;
+
+    ShopCatalog large;
+    std::string error;
+    large.parse(makeCatalog(2000), error, "generated");
+
+    AutoBuyPolicy everything;
+    AutoBuyPolicy thrifty;
+    thrifty.upgrades = false;
+    thrifty.buildingLimit = 25;
+    thrifty.reserve = 200;
+
+    struct Run {
+        const char* name;
+        const ShopCatalog* catalog;
+        AutoBuyPolicy policy;
+    } runs[] = {
+        { "standard shop, buy all", &ShopCatalog::standard(), everything },
+        { "standard shop, thrifty", &ShopCatalog::standard(), thrifty },
+        { "6000 items, buy all", &large, everything },
+    };
+
+    bool allSame = true;
+    for (const Run& run : runs) {
+        Outcome none = idle(*run.catalog, Mode::Idle, run.policy, frames);
+        Outcome heap = idle(*run.catalog, Mode::AutoBuyer, run.policy, frames);
+        Outcome scan = idle(*run.catalog, Mode::Scan, run.policy, frames);
+        bool same = heap.state == scan.state;
+        allSame = allSame && same;
+
+        std::cout << run.name << " (" << frames << " frames):\n" << std::fixed << std::setprecision(1)
+                  << "  no automation: " << std::setw(10) << none.nsPerFrame << " ns/frame\n"
+                  << "  autobuyer:     " << std::setw(10) << heap.nsPerFrame << " ns/frame, " << heap.actions
+                  << " actions, " << std::setprecision(2) << heap.nsPerCheck << " ns per idle check\n"
+                  << std::setprecision(1)
+                  << "  scan:          " << std::setw(10) << scan.nsPerFrame << " ns/frame, " << scan.actions
+                  << " actions\n"
+                  << "  final state:   " << heap.state << (same ? " (same)" : "\n  scan ended:    " + scan.state)
+                  << "\n\n";
+    }
+    return allSame ? 0 : 1;
+}
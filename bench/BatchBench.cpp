@@ -0,0 +1,76 @@
+// Steps N games one Simulation at a time and as one BatchEnv, checks that both
+// end in the same place and reports the throughput of each.
+// Build: g++ -std=c++17 -O3 -march=native -fno-trapping-math bench/BatchBench.cpp core/GameCore.cpp core/ShopCatalog.cpp core/BigNumber.cpp core/Simulation.cpp core/MessageBoard.cpp core/BatchEnv.cpp -o batchbench
+// Usage: batchbench [games] [frames]
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <memory>
+#include <vector>
+
+#include "../core/BatchEnv.h"
+
+using namespace piegame;
+
+// A main-game position somewhere between the first grandma and the goal
+static void randomGame(Simulation& sim, std::mt19937& rng) {
+    auto pick = [&](int lo, int hi) { return std::uniform_int_distribution<int>(lo, hi)(rng); };
+    sim.skipIntro();
+    sim.game.totalPies = pick(0, 900000);
+    sim.catSystem.milkPurchased = pick(0, 3) == 0 ? pick(1, 200) : 0;
+    sim.catSystem.catnipLevel = sim.catSystem.milkPurchased > 0 ? pick(0, 15) : 0;
+    sim.prestigeShop.boostPercent = pick(0, 50);
+    sim.buildings.setBoostPercent(sim.prestigeShop.boostPercent);
+    for (auto& item : sim.shopItems) {
+        if (dynamic_cast<Building*>(item.get())) {
+            for (int n = pick(0, 60); n > 0; --n) item->purchase();
+        } else if (pick(0, 1)) {
+            item->purchase();
+        }
+    }
+    sim.game.piesPerSecond = calculatePiesPerSecond(sim.shopItems);
+}
+
+int main(int argc, char** argv) {
+    size_t games = argc > 1 ? (size_t)atoll(argv[1]) : 4096;
+    int frames = argc > 2 ? atoi(argv[2]) : 900;
+    const float frameTime = 1.0f / 30.0f;
+
+    std::mt19937 rng(2024);
+    std::vector<std::unique_ptr<Simulation>> sims;
+    BatchEnv batch(games);
+    for (size_t g = 0; g < games; ++g) {
+        sims.push_back(std::make_unique<Simulation>());
+        randomGame(*sims.back(), rng);
+        batch.load(g, *sims.back());
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; ++f) {
+        for (auto& sim : sims) sim->step(frameTime);
+    }
+    double scalarSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; ++f) batch.step(frameTime);
+    double batchSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    size_t identical = 0;
+    long long worst = 0;
+    for (size_t g = 0; g < games; ++g) {
+        long long diff = std::llabs(sims[g]->game.totalPies.toInt64() - batch.totalPies[g]);
+        if (diff == 0 && sims[g]->game.ratSystem.getTotalRats() == batch.totalRats[g]) identical++;
+        if (diff > worst) worst = diff;
+    }
+
+    double steps = (double)games * frames;
+    std::cout << "games:              " << games << "\n"
+              << "frames:             " << frames << "\n"
+              << "scalar game-steps/s " << (long long)(steps / scalarSeconds) << "\n"
+              << "batch game-steps/s  " << (long long)(steps / batchSeconds) << "\n"
+              << "speedup:            " << scalarSeconds / batchSeconds << "x\n"
+              << "identical games:    " << identical << "/" << games
+              << " (largest pie difference " << worst << ")\n";
+    return identical == games ? 0 : 1;
+}
@@ -0,0 +1,65 @@
+// Times "buy a building, then read pies per second" as the catalog grows:
+// walking the shop list (calculatePiesPerSecond) against the BuildingTable's
+// running total.
+// Build: g++ -std=c++17 -O2 bench/BuildingBench.cpp core/GameCore.cpp core/ShopCatalog.cpp core/BigNumber.cpp -o buildingbench
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <memory>
+
+#include "../core/GameCore.h"
+
+using namespace piegame;
+
+// A catalog of n buildings with an upgrade after every third one, like the real shop
+static void makeCatalog(int n, ShopList& shop, BuildingTable& table) {
+    shop.clear();
+    table.reset(10);
+    for (int i = 0; i < n; ++i) {
+        auto building = std::make_unique<Building>("Building " + std::to_string(i), table,
+                                                   table.add(10 + i * 7, 1 + i % 13));
+        Building* target = building.get();
+        shop.push_back(std::move(building));
+        if (i % 3 == 2) shop.push_back(std::make_unique<Upgrade>("Upgrade", 100, 2.0f, target));
+    }
+}
+
+int main() {
+    const int sizes[] = { 3, 30, 300, 3000, 30000 };
+    const int operations = 200000;
+
+    std::cout << std::left << std::setw(10) << "buildings" << std::setw(16) << "walk ns/op"
+              << std::setw(16) << "table ns/op" << "totals agree\n";
+
+    for (int n : sizes) {
+        ShopList shop;
+        BuildingTable table;
+        makeCatalog(n, shop, table);
+        long long sink = 0;
+
+        // Old way: every purchase is followed by a walk over the whole shop
+        int walkOps = std::max(200, operations / n);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < walkOps; ++i) {
+            shop[(i * 7919) % shop.size()]->purchase();
+            sink += calculatePiesPerSecond(shop).toInt64();
+        }
+        double walkNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / walkOps;
+
+        // New way: the table already knows the total
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < operations; ++i) {
+            shop[(i * 7919) % shop.size()]->purchase();
+            sink += table.getTotalPiesPerSecond().toInt64();
+        }
+        double tableNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / operations;
+
+        bool agree = calculatePiesPerSecond(shop) == table.getTotalPiesPerSecond();
+        table.setBoostPercent(25); // Mid-run Boost% change takes the slow path
+        agree = agree && calculatePiesPerSecond(shop) == table.getTotalPiesPerSecond();
+
+        std::cout << std::setw(10) << n << std::setw(16) << walkNs << std::setw(16) << tableNs
+                  << (agree ? "yes" : "NO") << (sink == 42 ? " " : "") << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,110 @@
+// Checks the closed-form bulk prices against buying one building at a time,
+// for odd and even base costs and from several starting counts, then times
+// "buy N" and "buy max" both ways: the per-unit loop of getCost/purchase
+// against one Action with a count, in a Simulation and in a BatchEnv slot.
+// Build: g++ -std=c++17 -O2 bench/BulkBench.cpp core/GameCore.cpp core/ShopCatalog.cpp core/BigNumber.cpp core/Simulation.cpp core/MessageBoard.cpp core/BatchEnv.cpp -o bulkbench
+// Usage: bulkbench
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+#include "../core/BatchEnv.h"
+
+using namespace piegame;
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// The old way: one unit at a time, as many as `pies` pays for
+static long long buyOneByOne(BuildingTable& table, int row, BigNumber& pies, long long most) {
+    long long bought = 0;
+    while (bought < most && pies >= table.getCost(row)) {
+        pies -= table.getCost(row);
+        table.addCount(row, 1);
+        bought++;
+    }
+    return bought;
+}
+
+int main() {
+    // Exactness: every n up to 2,000 from each start, both parities of base cost
+    const int bases[] = { 1, 10, 15, 50, 199, 200 };
+    const int starts[] = { 0, 1, 7, 1000 };
+    long long priceMismatches = 0, maxMismatches = 0, checked = 0;
+    for (int base : bases) {
+        for (int owned : starts) {
+            BuildingTable table;
+            table.reset(0);
+            int row = table.add(base, 1);
+            table.addCount(row, owned);
+            BigNumber running;
+            for (int n = 1; n <= 2000; ++n) {
+                running += table.getCost(row);
+                table.addCount(row, 1);
+                priceMismatches += bulkBuildingCost(base, owned, n) != running;
+                // The most `running` (and one pie less) pays for
+                maxMismatches += affordableBuildings(base, owned, running) != n;
+                maxMismatches += affordableBuildings(base, owned, running - 1) != n - 1;
+                checked++;
+            }
+        }
+    }
+    std::cout << "bulk prices checked: " << checked << ", price mismatches " << priceMismatches
+              << ", max mismatches " << maxMismatches << "\n";
+
+    // Past the small tier: a price near 10^20 still comes out, and max stays below INT_MAX
+    std::cout << "10^9 Factories from 0: " << bulkBuildingCost(200, 0, 1000000000) << " pies, max for 10^30: "
+              << affordableBuildings(200, 0, BigNumber::fromDouble(1e30)) << "\n\n";
+
+    std::cout << std::left << std::setw(10) << "units" << std::setw(16) << "loop us" << std::setw(16)
+              << "bulk us" << "same state\n";
+    const int amounts[] = { 10, 100, 1000, 100000 };
+    bool allSame = true;
+    for (int units : amounts) {
+        const int repeats = std::max(20, 2000000 / units);
+
+        // The old way, on a bare table
+        BuildingTable table;
+        table.reset(0);
+        int row = table.add(10, 1);
+        BigNumber left;
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r) {
+            table.setRow(row, 0, 1.0f);
+            left = bulkBuildingCost(10, 0, units);
+            buyOneByOne(table, row, left, units);
+        }
+        double loopUs = secondsSince(start) / repeats * 1e6;
+
+        // One action in a Simulation, Grandma x units
+        Simulation sim;
+        sim.skipIntro();
+        BigNumber price = bulkBuildingCost(10, 0, units);
+        start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r) {
+            sim.buildings.setRow(0, 0, 1.0f);
+            sim.game.totalPies = price;
+            sim.apply({ ActionType::BuyItem, 0, units });
+        }
+        double bulkUs = secondsSince(start) / repeats * 1e6;
+
+        bool same = sim.buildings.row(0).count == table.row(row).count && sim.game.totalPies == left &&
+                    sim.game.piesPerSecond == table.getTotalPiesPerSecond();
+
+        // Buy max, and in a batch slot
+        sim.buildings.setRow(0, 0, 1.0f);
+        sim.game.totalPies = price + 5;
+        same = same && sim.apply({ ActionType::BuyItem, 0, BUY_MAX }) && sim.buildings.row(0).count == units;
+        BatchEnv batch(1);
+        batch.load(0, sim);
+        batch.buildingCount[0][0] = 0;
+        batch.totalPies[0] = price.toInt();
+        if (price.toInt64() < INT_MAX) same = same && batch.buyBuildings(0, 0, BUY_MAX) == units && batch.totalPies[0] == 0;
+        allSame = allSame && same;
+
+        std::cout << std::setw(10) << units << std::setw(16) << loopUs << std::setw(16) << bulkUs
+                  << (same ? "yes" : "NO") << "\n";
+    }
+    return priceMismatches || maxMismatches || !allSame ? 1 : 0;
+}
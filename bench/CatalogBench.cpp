@@ -0,0 +1,148 @@
+// Builds shop catalogs of growing size and times what scales with them:
+// parsing, starting a run, the per-frame visibility check (the heap of
+// thresholds against the old walk over every item) and rendering a page.
+// Also checks that both visibility paths list the same items, and that
+// broken catalogs are turned away with an error.
+// Build: g++ -std=c++17 -O2 bench/CatalogBench.cpp core/GameCore.cpp core/ShopCatalog.cpp core/BigNumber.cpp core/Simulation.cpp core/MessageBoard.cpp core/FastForward.cpp core/FrameProfiler.cpp ui/ScreenBuffer.cpp ui/Render.cpp -o catalogbench
+// Usage: catalogbench [frames]
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "../ui/Render.h"
+
+using namespace piegame;
+
+const float FRAME = 1.0f / 30.0f;
+
+// n buildings with costs spread over the run, each with a chain of two upgrades
+static std::string makeCatalog(int n) {
+    std::string text = "# Generated\n";
+    for (int i = 0; i < n; ++i) {
+        text += "building | B" + std::to_string(i) + " | " + std::to_string(10 + i * 37) + " | " +
+                std::to_string(1 + i % 13) + "\n";
+    }
+    for (int i = 0; i < n; ++i) {
+        std::string b = std::to_string(i);
+        text += "upgrade | U" + b + " | " + std::to_string(500 + i * 91) + " | 2 | B" + b + "\n";
+        text += "upgrade | V" + b + " | " + std::to_string(5000 + i * 97) + " | 1.5 | B" + b + " | U" + b + "\n";
+    }
+    return text;
+}
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// The shop loop stepGame ran before the visibility heap
+static void walkShop(ShopList& items, const BigNumber& pies) {
+    for (auto& item : items) {
+        if (item->isVisible(pies)) item->setWasVisible();
+    }
+}
+
+// Buys the first thing it can afford every few frames, like the tick benchmark
+static void playFrame(Simulation& sim, int frame) {
+    if (sim.intro.inIntro) {
+        if (sim.intro.unlockAvailable) sim.apply({ ActionType::UnlockBuildings });
+        else sim.apply({ ActionType::BakePie });
+        return;
+    }
+    sim.game.totalPies += 40; // A steady trickle, so new items keep showing up
+    if (frame % 5 != 0) return;
+    for (int slot : std::vector<int>(sim.listedItems())) {
+        if (sim.apply({ ActionType::BuyItem, slot })) break;
+    }
+}
+
+int main(int argc, char** argv) {
+    int frames = argc > 1 ? atoi(argv[1]) : 20000;
+    const int sizes[] = { 3, 100, 1000, 10000 };
+    bool allAgree = true;
+
+    std::cout << std::left << std::setw(8) << "items" << std::setw(12) << "parse ms" << std::setw(12) << "run ms"
+              << std::setw(14) << "heap p50 ns" << std::setw(14) << "walk ns" << std::setw(14) << "render us/f"
+              << "listed agree\n";
+
+    for (int n : sizes) {
+        std::string text = makeCatalog(n);
+        ShopCatalog catalog;
+        std::string error;
+        auto start = std::chrono::steady_clock::now();
+        if (!catalog.parse(text, error)) {
+            std::cerr << error << "\n";
+            return 1;
+        }
+        double parseMs = secondsSince(start) * 1e3;
+
+        start = std::chrono::steady_clock::now();
+        Simulation sim(catalog);
+        double runMs = secondsSince(start) * 1e3;
+        sim.skipIntro();
+
+        // The heap: the median Shop phase of a frame, read off the profiler
+        FrameProfiler timings;
+        sim.profiler = &timings;
+        PieAnimation anim;
+        MainScreenWidgets widgets;
+        ScreenBuffer screen(CONSOLE_WIDTH, CONSOLE_HEIGHT);
+        double renderSeconds = 0.0;
+        for (int f = 0; f < frames; ++f) {
+            playFrame(sim, f);
+            sim.step(FRAME);
+            if (f % 10 == 0) {
+                start = std::chrono::steady_clock::now();
+                renderFrame(screen, widgets, sim, anim);
+                renderSeconds += secondsSince(start);
+            }
+        }
+        sim.profiler = nullptr;
+        double heapNs = (double)timings.histogram(FramePhase::Shop).percentile(0.5);
+
+        // The walk, over the same items at the same pie count
+        int walks = std::max(50, 2000000 / (int)sim.shopItems.size());
+        start = std::chrono::steady_clock::now();
+        for (int w = 0; w < walks; ++w) walkShop(sim.shopItems, sim.game.totalPies);
+        double walkNs = secondsSince(start) / walks * 1e9;
+
+        // After the walk, every item it marks visible and not bought should be listed
+        std::vector<int> walked;
+        for (int slot = 0; slot < (int)sim.shopItems.size(); ++slot) {
+            const ShopItem& item = *sim.shopItems[slot];
+            bool bought = catalog[slot].kind == ShopKind::Upgrade && static_cast<const Upgrade&>(item).isPurchased();
+            if (item.hasBeenVisible() && !bought) walked.push_back(slot);
+        }
+        bool agree = walked == sim.listedItems();
+        allAgree = allAgree && agree;
+
+        std::cout << std::setw(8) << catalog.size() << std::setw(12) << std::setprecision(3) << parseMs
+                  << std::setw(12) << runMs << std::setw(14) << heapNs << std::setw(14) << walkNs << std::setw(14)
+                  << renderSeconds / (frames / 10) * 1e6 << (agree ? "yes" : "NO") << " (" << walked.size()
+                  << " listed)\n";
+    }
+
+    // Catalogs that must not load
+    const char* broken[] = {
+        "",
+        "building | A | 10\n",
+        "building | A | ten | 1\n",
+        "building | A | 10 | 1\nbuilding | A | 20 | 2\n",
+        "upgrade | U | 100 | 2 | Nowhere\n",
+        "building | A | 10 | 1\nupgrade | U | 100 | 2 | A | Later\nupgrade | Later | 50 | 2 | A\n",
+        "building | A | 10 | 1\nupgrade | U | 100 | 0 | A\n",
+        "shop | A | 10 | 1\n",
+    };
+    int accepted = 0;
+    std::cout << "\nBroken catalogs:\n";
+    for (const char* text : broken) {
+        ShopCatalog catalog;
+        std::string error;
+        if (catalog.parse(text, error, "test")) ++accepted;
+        std::cout << "  " << (error.empty() ? "(accepted)" : error) << "\n";
+    }
+    return allAgree && accepted == 0 ? 0 : 1;
+}
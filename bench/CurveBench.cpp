@@ -0,0 +1,132 @@
+// Checks the curve tables against the exact libm formulas and times both:
+// every whole pie count from the rat threshold to 1,000,000 for the rat
+// count, every catnip level, and the smooth rat curve between the knots.
+// Then plays the tick benchmark's player on both paths and compares the
+// final states.
+// Build: g++ -std=c++17 -O2 bench/CurveBench.cpp core/GameCore.cpp core/ShopCatalog.cpp core/BigNumber.cpp core/Simulation.cpp core/MessageBoard.cpp -o curvebench
+// Usage: curvebench [ticks]
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+
+#include "../core/Curves.h"
+#include "../core/Simulation.h"
+
+using namespace piegame;
+
+const float FRAME = 1.0f / 30.0f;
+
+// Nanoseconds per call of op, on the exact path and on the tables
+static void timeBoth(const char* name, long long calls, const std::function<double(long long)>& op) {
+    double seconds[2];
+    for (int exact = 1; exact >= 0; --exact) {
+        setExactCurves(exact != 0);
+        volatile double sink = 0.0;
+        auto start = std::chrono::steady_clock::now();
+        for (long long i = 0; i < calls; ++i) sink = sink + op(i);
+        seconds[exact] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+    printf("%-28s %10.1f ns %10.1f ns %8.1fx\n", name, seconds[1] / calls * 1e9, seconds[0] / calls * 1e9,
+           seconds[1] / seconds[0]);
+}
+
+// The tick benchmark's scripted player
+static void playTick(Simulation& sim) {
+    if (sim.intro.inIntro) {
+        if (sim.intro.unlockAvailable) sim.apply({ ActionType::UnlockBuildings });
+        else sim.apply({ ActionType::BakePie });
+        return;
+    }
+    sim.apply({ ActionType::BakePie });
+    for (int i = 0; i < (int)sim.shopItems.size(); ++i) {
+        if (sim.apply({ ActionType::BuyItem, i })) break;
+    }
+    if (sim.goalReached()) {
+        sim.apply({ ActionType::Prestige });
+        while (sim.apply({ ActionType::BuyPrestigeUpgrade, 0 })) {}
+        sim.apply({ ActionType::LeavePrestigeShop });
+    }
+}
+
+int main(int argc, char** argv) {
+    long long ticks = argc > 1 ? atoll(argv[1]) : 3000000;
+
+    RatSystem rats;
+    CatSystem noCats;
+    const int threshold = rats.getThreshold();
+    const int top = 1000000;
+
+    // Rat counts: tick() with no pies per second leaves the pie count alone
+    long long countMismatches = 0;
+    for (int pies = threshold; pies <= top; ++pies) {
+        int counts[2];
+        for (int exact = 0; exact < 2; ++exact) {
+            setExactCurves(exact != 0);
+            BigNumber total(pies);
+            rats.tick(total, BigNumber(), noCats);
+            counts[exact] = rats.getTotalRats();
+        }
+        countMismatches += counts[0] != counts[1];
+    }
+
+    int catnipMismatches = 0;
+    for (int level = 0; level < 60; ++level) {
+        CatSystem cats;
+        cats.catnipLevel = level;
+        setExactCurves(true);
+        int exact = cats.ratsEatenPerCat();
+        setExactCurves(false);
+        catnipMismatches += exact != cats.ratsEatenPerCat();
+    }
+
+    // The smooth curve, at points that are never knots
+    double worst = 0.0, worstAt = 0.0;
+    for (double pies = threshold; pies <= top; pies += 37.3) {
+        setExactCurves(true);
+        double exact = rats.ratCurve(pies, noCats);
+        setExactCurves(false);
+        double error = std::abs(rats.ratCurve(pies, noCats) / exact - 1.0);
+        if (error > worst) {
+            worst = error;
+            worstAt = pies;
+        }
+    }
+
+    std::cout << "rat count mismatches:        " << countMismatches << " of " << top - threshold + 1 << " pie counts\n"
+              << "rats per cat mismatches:     " << catnipMismatches << " of 60 catnip levels\n"
+              << "rat curve largest rel error: " << worst << " (at " << worstAt << " pies)\n\n";
+
+    printf("%-28s %13s %13s %9s\n", "", "exact", "tables", "speedup");
+    timeBoth("RatSystem::tick", 20000000, [&](long long i) {
+        BigNumber total(threshold + (int)(i * 7919 % (top - threshold)));
+        rats.tick(total, BigNumber(2000), noCats);
+        return (double)rats.getTotalRats();
+    });
+    timeBoth("RatSystem::ratCurve", 20000000, [&](long long i) {
+        return rats.ratCurve(threshold + (double)(i * 7919 % (top - threshold)) + 0.5, noCats);
+    });
+    timeBoth("CatSystem::ratsEatenPerCat", 20000000, [&](long long i) {
+        CatSystem cats;
+        cats.catnipLevel = (int)(i % 40);
+        return (double)cats.ratsEatenPerCat();
+    });
+
+    // Whole games on both paths
+    std::cout << "\n" << ticks << " ticks of the scripted player:\n";
+    for (int exact = 1; exact >= 0; --exact) {
+        setExactCurves(exact != 0);
+        Simulation sim;
+        auto start = std::chrono::steady_clock::now();
+        for (long long t = 0; t < ticks; ++t) {
+            playTick(sim);
+            sim.step(FRAME);
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << (exact ? "exact:  " : "tables: ") << (long long)(ticks / seconds) << " ticks/s, pies "
+                  << sim.game.totalPies << ", rats " << sim.game.ratSystem.getTotalRats() << ", stars "
+                  << sim.game.prestigeStars << "\n";
+    }
+    return countMismatches || catnipMismatches ? 1 : 0;
+}
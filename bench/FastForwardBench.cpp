@@ -0,0 +1,107 @@
+// Checks the fast-forward engine against frame-by-frame stepping and times its queries.
+// Build: g++ -std=c++17 -O2 bench/FastForwardBench.cpp core/GameCore.cpp core/ShopCatalog.cpp core/BigNumber.cpp core/Simulation.cpp core/MessageBoard.cpp core/FastForward.cpp -o ffbench
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+
+#include "../core/FastForward.h"
+
+using namespace piegame;
+
+struct Scenario {
+    const char* name;
+    int pies;
+    int piesPerSecond;
+    int milk;
+    int catnip;
+};
+
+static void setup(Simulation& sim, const Scenario& s) {
+    sim.startRun();
+    sim.skipIntro();
+    sim.game.totalPies = s.pies;
+    sim.game.piesPerSecond = s.piesPerSecond;
+    sim.catSystem.milkPurchased = s.milk;
+    sim.catSystem.catnipLevel = s.catnip;
+}
+
+int main() {
+    const Scenario scenarios[] = {
+        { "early game",        100,    40,   0,  0 },
+        { "crossing rats",   30000,   800,   0,  0 },
+        { "rat equilibrium", 60000,  3000,   0,  0 },
+        { "cats help",       60000,  3000, 200, 10 },
+        { "rats win",       800000,   100,   0,  0 },
+        { "late game",      200000, 40000,  50,  5 },
+    };
+    const double durations[] = { 10.0, 60.0, 600.0, 3600.0 };
+    const float frameTime = 1.0f / 30.0f;
+
+    std::cout << std::left << std::setw(18) << "scenario" << std::setw(10) << "seconds"
+              << std::setw(12) << "frames" << std::setw(12) << "fast-fwd"
+              << std::setw(10) << "error" << "allowed\n";
+
+    bool allOk = true;
+    for (const Scenario& s : scenarios) {
+        for (double seconds : durations) {
+            Simulation framed;
+            Simulation skipped;
+            setup(framed, s);
+            setup(skipped, s);
+
+            long long frames = (long long)std::llround(seconds / frameTime);
+            for (long long f = 0; f < frames && !framed.goalReached(); ++f) framed.step(frameTime);
+            fastForward(skipped, frames * (double)frameTime, GOAL_PIES);
+
+            double error = std::abs(framed.game.totalPies.toDouble() - skipped.game.totalPies.toDouble());
+            double allowed = std::max(0.005 * framed.game.totalPies.toDouble(), 2.0 * s.piesPerSecond);
+            bool ok = error <= allowed;
+            allOk = allOk && ok;
+            std::cout << std::setw(18) << s.name << std::setw(10) << seconds
+                      << std::setw(12) << framed.game.totalPies << std::setw(12) << skipped.game.totalPies
+                      << std::setw(10) << error << allowed << (ok ? "" : "  <-- FAIL") << "\n";
+        }
+    }
+
+    // "How long until 1,000,000 pies" against counting frames
+    std::cout << "\ntime until goal:\n";
+    const Scenario goalRuns[] = {
+        { "rats stall it",    1000,   100,   0,  0 },
+        { "no cats, no goal", 1000, 20000,   0,  0 },
+        { "cats clear a path", 1000,  9000, 400, 12 },
+        { "barely enough cats", 1000, 2500, 300, 12 },
+        { "slow but steady",  1000,   600, 150, 14 },
+    };
+    for (const Scenario& s : goalRuns) {
+        Simulation framed;
+        Simulation query;
+        setup(framed, s);
+        setup(query, s);
+
+        double predicted = timeUntilPies(query, GOAL_PIES);
+        long long frames = 0;
+        while (!framed.goalReached() && frames < 30LL * 3600 * 24) {
+            framed.step(frameTime);
+            ++frames;
+        }
+        double actual = framed.goalReached() ? frames * (double)frameTime : INFINITY;
+
+        const int repeats = 20000;
+        auto start = std::chrono::steady_clock::now();
+        double sink = 0.0;
+        for (int i = 0; i < repeats; ++i) sink += timeUntilPies(query, GOAL_PIES - (i & 7));
+        auto end = std::chrono::steady_clock::now();
+        double micros = std::chrono::duration<double, std::micro>(end - start).count() / repeats;
+
+        bool ok = (std::isinf(predicted) && std::isinf(actual)) ||
+                  std::abs(predicted - actual) <= std::max(0.005 * actual, 2.0 * frameTime);
+        allOk = allOk && ok;
+        std::cout << "  " << std::setw(20) << s.name << " predicted " << std::setw(12) << predicted
+                  << " frames " << std::setw(12) << actual << " (" << micros << " us/query)"
+                  << (ok ? "" : "  <-- FAIL") << (sink < 0 ? "!" : "") << "\n";
+    }
+
+    std::cout << (allOk ? "\nall within the stated bound\n" : "\nOUT OF BOUND\n");
+    return allOk ? 0 : 1;
+}
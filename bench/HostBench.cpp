@@ -0,0 +1,123 @@
+// Runs thousands of scripted players in one SessionHost at several thread
+// counts, checks every session against the same script played on its own
+// Simulation, and reports memory per session and tick cost per session.
+// Build: g++ -std=c++17 -O2 -pthread bench/HostBench.cpp core/GameCore.cpp core/ShopCatalog.cpp core/BigNumber.cpp core/Simulation.cpp core/MessageBoard.cpp core/SessionHost.cpp -o hostbench
+// Usage: hostbench [sessions] [frames]
+#include <iostream>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../core/SessionHost.h"
+
+using namespace piegame;
+
+const float FRAME = 1.0f / 30.0f;
+
+// Live heap bytes: every allocation carries its size in front
+static std::atomic<long long> liveBytes{ 0 };
+const size_t HEADER = alignof(std::max_align_t);
+
+void* operator new(size_t size) {
+    char* block = static_cast<char*>(malloc(size + HEADER));
+    if (!block) throw std::bad_alloc();
+    *reinterpret_cast<size_t*>(block) = size;
+    liveBytes += (long long)size;
+    return block + HEADER;
+}
+
+void operator delete(void* p) noexcept {
+    if (!p) return;
+    char* block = static_cast<char*>(p) - HEADER;
+    liveBytes -= (long long)*reinterpret_cast<size_t*>(block);
+    free(block);
+}
+
+void operator delete(void* p, size_t) noexcept { operator delete(p); }
+
+// A player's keys for one frame: a few SPACE presses, now and then a
+// purchase, the unlock, or a prestige and a trip through the shop
+static std::string keysFor(size_t player, int frame) {
+    std::mt19937 rng((unsigned)(player * 7919 + (size_t)frame * 104729));
+    auto roll = [&](int n) { return std::uniform_int_distribution<int>(0, n - 1)(rng); };
+    std::string keys(roll(4), ' ');
+    if (roll(8) == 0) keys += (char)('1' + roll(6));
+    if (roll(30) == 0) keys += 'U';
+    if (roll(600) == 0) keys += "R10";
+    return keys;
+}
+
+// The same frame on a lone Simulation, as SessionHost plays it
+static void playAlone(Simulation& sim, const std::string& keys) {
+    for (char key : keys) {
+        if (sim.goalReached()) continue;
+        Action action;
+        if (actionForKey(sim, key, action)) sim.apply(action);
+    }
+    if (!sim.goalReached() && !sim.inPrestigeShop()) sim.step(FRAME);
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? (size_t)atoll(argv[1]) : 4096;
+    int frames = argc > 2 ? atoi(argv[2]) : 300;
+
+    std::vector<unsigned> threadCounts = { 1, 2, 4 };
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    if (cores > 4) threadCounts.push_back(cores);
+
+    // Reference: each script on its own Simulation
+    std::vector<std::unique_ptr<Simulation>> alone;
+    for (size_t i = 0; i < count; ++i) alone.push_back(std::make_unique<Simulation>());
+    for (int f = 0; f < frames; ++f) {
+        for (size_t i = 0; i < count; ++i) playAlone(*alone[i], keysFor(i, f));
+    }
+
+    std::cout << count << " sessions, " << frames << " frames each, " << cores << " cores\n"
+              << "sizeof(Simulation) " << sizeof(Simulation) << " bytes\n\n";
+
+    for (unsigned threads : threadCounts) {
+        SessionHost host(threads);
+        std::vector<int> ids;
+        ids.reserve(count);
+        long long before = liveBytes;
+        for (size_t i = 0; i < count; ++i) ids.push_back(host.open());
+
+        double total = 0.0, slowestShard = 0.0;
+        for (int f = 0; f < frames; ++f) {
+            for (size_t i = 0; i < count; ++i) {
+                for (char key : keysFor(i, f)) host.send(ids[i], key);
+            }
+            auto began = std::chrono::steady_clock::now();
+            host.tick(FRAME);
+            total += std::chrono::duration<double>(std::chrono::steady_clock::now() - began).count();
+            slowestShard += host.lastTickSeconds();
+        }
+        long long after = liveBytes; // Sessions as played (announcements, key buffers)
+
+        size_t same = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const SessionView& view = *host.view(ids[i]);
+            const Simulation& sim = *alone[i];
+            same += view.pies == sim.game.totalPies.toDouble()
+                 && view.piesPerSecond == sim.game.piesPerSecond.toDouble()
+                 && view.rats == sim.game.ratSystem.getTotalRats()
+                 && view.prestigeStars == sim.game.prestigeStars;
+        }
+
+        double perTick = total / frames;
+        std::cout << threads << " thread" << (threads > 1 ? "s: " : ":  ")
+                  << (after - before) / (double)count / 1024.0 << " KB/session, "
+                  << perTick * 1e3 << " ms/tick (slowest shard " << slowestShard / frames * 1e3 << " ms), "
+                  << perTick / count * 1e9 << " ns per session-tick, "
+                  << (long long)(FRAME / (perTick / count)) << " sessions fit a 30 Hz frame, "
+                  << same << "/" << count << " match alone\n";
+    }
+    return 0;
+}
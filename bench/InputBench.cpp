@@ -0,0 +1,73 @@
+// Feeds bursts of key presses through the input thread (POSIX backend, from
+// a pipe on stdin) to a game loop that drains the queue once per frame, and
+// counts what arrives against what the old once-per-frame key polling saw.
+// Build: g++ -std=c++17 -O2 -pthread bench/InputBench.cpp ui/Input.cpp -o inputbench
+// Usage: inputbench [bursts] [pressesPerBurst]
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+#include "../ui/Input.h"
+
+using namespace piegame;
+using Clock = std::chrono::steady_clock;
+
+int main(int argc, char** argv) {
+    int bursts = argc > 1 ? atoi(argv[1]) : 200;
+    int perBurst = argc > 2 ? atoi(argv[2]) : 8;
+
+    // The input thread reads stdin; make that a pipe we write to
+    int fds[2];
+    if (pipe(fds) != 0 || dup2(fds[0], STDIN_FILENO) < 0) return 1;
+    InputThread input;
+    input.start();
+
+    // The "player": bursts of SPACE presses (like mashing the key), each
+    // burst written at once, 20 ms apart; arrow keys in between must not count
+    std::thread player([&] {
+        std::string burst(perBurst, ' ');
+        burst += "\x1b[A";
+        for (int b = 0; b < bursts; ++b) {
+            if (write(fds[1], burst.data(), burst.size()) < 0) break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+    });
+
+    // The game: 30 FPS frames that wake early for input, as the front end does
+    long long received = 0, framesWithKeys = 0;
+    std::vector<double> latencyMicros;
+    long long expected = (long long)bursts * perBurst;
+    auto deadline = Clock::now() + std::chrono::seconds(30);
+    while (received < expected && Clock::now() < deadline) {
+        input.wait(1.0f / 30.0f);
+        KeyEvent event;
+        bool any = false;
+        while (input.poll(event)) {
+            latencyMicros.push_back(std::chrono::duration<double, std::micro>(Clock::now() - event.when).count());
+            received += event.key == ' ';
+            any = true;
+        }
+        framesWithKeys += any;
+    }
+    player.join();
+    input.stop();
+
+    std::sort(latencyMicros.begin(), latencyMicros.end());
+    auto percentile = [&](double p) {
+        return latencyMicros.empty() ? 0.0 : latencyMicros[(size_t)(p * (latencyMicros.size() - 1))];
+    };
+    // Polling GetAsyncKeyState once per 33 ms frame sees at most one press
+    // per key per frame, and none that start and end between two frames
+    long long polledAtBest = (long long)bursts * 20 / 33 + 1;
+    std::cout << "presses sent:       " << expected << "\n"
+              << "presses received:   " << received << (received == expected ? " (none lost)" : " (LOST SOME)") << "\n"
+              << "old polling, best:  " << std::min(polledAtBest, expected) << " (one per frame at most)\n"
+              << "queue to game:      median " << percentile(0.5) << " us, p99 " << percentile(0.99) << " us\n"
+              << "frames with keys:   " << framesWithKeys << "\n";
+    return received == expected ? 0 : 1;
+}
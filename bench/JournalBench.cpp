@@ -0,0 +1,118 @@
+// Records an hour of play through the input journal, as the console game
+// does, then replays it at full speed and checks it ends in the same game.
+// A second session starts from a save and is replayed the same way.
+// Build: g++ -std=c++17 -O2 bench/JournalBench.cpp core/GameCore.cpp core/ShopCatalog.cpp core/BigNumber.cpp core/Simulation.cpp core/MessageBoard.cpp core/SaveFile.cpp core/InputJournal.cpp -o journalbench
+// Usage: journalbench [minutes]
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../core/InputJournal.h"
+#include "../core/SaveFile.h"
+
+using namespace piegame;
+
+// A human-paced player: a bake every few frames, a purchase attempt now and
+// then, a prestige at the goal. Frame times wobble around Sleep(33).
+struct Player {
+    unsigned seed = 12345;
+
+    unsigned next() { return seed = seed * 1103515245u + 12345u; }
+
+    float frameTime() { return 0.030f + (next() >> 16) % 7000 / 1e6f; }
+
+    void play(JournalWriter& journal, Simulation& sim) {
+        unsigned roll = (next() >> 16) % 100;
+        if (roll < 25) journal.apply(sim, { ActionType::BakePie });
+        if (sim.intro.inIntro) {
+            if (sim.intro.unlockAvailable && roll > 90) journal.apply(sim, { ActionType::UnlockBuildings });
+            return;
+        }
+        if (roll > 93) {
+            for (int i = (int)sim.shopItems.size() - 1; i >= 0; --i) {
+                if (journal.apply(sim, { ActionType::BuyItem, i })) break;
+            }
+        }
+        if (sim.goalReached()) {
+            journal.apply(sim, { ActionType::Prestige });
+            while (journal.apply(sim, { ActionType::BuyPrestigeUpgrade, 0 })) {}
+            journal.apply(sim, { ActionType::LeavePrestigeShop });
+        }
+    }
+};
+
+// Everything a replay should reproduce, as text
+static std::string describe(const Simulation& sim) {
+    std::ostringstream out;
+    out << sim.game << " pps " << sim.game.piesPerSecond << " baked " << sim.game.piesBakedThisRun
+        << " carry " << sim.game.pieCarry << "/" << sim.game.ratSystem.getEatenCarry()
+        << " unticked " << sim.game.untickedSeconds << " boost " << sim.prestigeShop.boostPercent
+        << " intro " << sim.intro.inIntro << " messages";
+    for (int line = 0; line < sim.messages.lineCount(); ++line) out << " [" << sim.messages.lineText(line) << "]";
+    if (sim.messages.active()) out << " " << sim.messages.secondsUntilChange() << " s, " << sim.messages.waiting() << " waiting";
+    for (const auto& item : sim.shopItems) out << " | " << item->getCost() << "/" << item->getPiesPerSecond();
+    return out.str();
+}
+
+// Replays `path` into a new game; true if it matches `live`
+static bool replayAndCompare(const char* label, const char* path, const Simulation& live) {
+    Journal journal;
+    Simulation replayed;
+    Journal::Stats stats;
+    bool loaded = journal.load(path);
+    auto start = std::chrono::steady_clock::now();
+    bool ran = loaded && journal.replay(replayed, &stats);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    bool same = ran && describe(live) == describe(replayed);
+
+    std::cout << label << "\n"
+              << "  journal:  " << journal.entryBytes() << " bytes for " << stats.frames << " frames, "
+              << stats.actions << " actions (" << journal.entryBytes() * 3600.0 / (stats.seconds > 0 ? stats.seconds : 1) / 1000.0
+              << " KB per hour)\n"
+              << "  replay:   " << stats.seconds << " s of play in " << ms << " ms ("
+              << stats.seconds * 1000.0 / (ms > 0 ? ms : 1) << "x real time)\n"
+              << "  result:   " << (same ? "identical to the live game" : "DIFFERENT from the live game") << "\n";
+    return same;
+}
+
+int main(int argc, char** argv) {
+    double minutes = argc > 1 ? atof(argv[1]) : 60.0;
+    const char* journalPath = "journalbench.journal";
+    const char* savePath = "journalbench.sav";
+    bool ok = true;
+
+    // Session 1: a new game
+    Player player;
+    Simulation live;
+    JournalWriter journal;
+    ok = journal.begin(journalPath) && ok;
+    journal.startRun(live);
+    for (double t = 0.0; t < minutes * 60.0;) {
+        player.play(journal, live);
+        float dt = player.frameTime();
+        journal.step(live, dt);
+        t += dt;
+    }
+    journal.close();
+    ok = replayAndCompare("new game:", journalPath, live) && ok;
+
+    // Session 2: picks up from a save of session 1
+    ok = saveGame(savePath, live) && ok;
+    Simulation resumed;
+    ok = loadGame(savePath, resumed) && ok;
+    ok = journal.begin(journalPath, savePath) && ok;
+    for (double t = 0.0; t < minutes * 6.0;) {
+        player.play(journal, resumed);
+        float dt = player.frameTime();
+        journal.step(resumed, dt);
+        t += dt;
+    }
+    journal.close();
+    ok = replayAndCompare("from a save:", journalPath, resumed) && ok;
+
+    std::remove(journalPath);
+    std::remove(savePath);
+    return ok ? 0 : 1;
+}
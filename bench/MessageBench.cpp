@@ -0,0 +1,177 @@
+// Two parts. First the TimerWheel on its own against a binary min-heap:
+// schedule n timers over ten minutes, then run 60 FPS frames until all have
+// expired. Both must expire the same timers in the same frames; the wheel's
+// cost per timer should stay flat as n grows while the heap's climbs with
+// log n. Then the MessageBoard under the bursts the game produces (one
+// building bought every frame, every intro milestone at once, a flood of
+// different purchases behind a tip), checking that every message makes it
+// onto a line and how long the board keeps it waiting.
+// Build: g++ -std=c++17 -O2 bench/MessageBench.cpp core/MessageBoard.cpp -o messagebench
+// Usage: messagebench [timers]
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../core/MessageBoard.h"
+
+using namespace piegame;
+
+const double FRAME = 1.0 / 60.0;
+
+struct Run {
+    double nsPerTimer; // Scheduling and expiring, per timer
+    uint64_t check;    // Sum of frame * id over the expiries
+};
+
+static Run runWheel(const std::vector<double>& delays) {
+    TimerWheel wheel(MESSAGE_RESOLUTION);
+    Run run{ 0.0, 0 };
+    size_t left = delays.size();
+    uint64_t frame = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t id = 0; id < delays.size(); ++id) wheel.schedule(id, delays[id]);
+    while (left > 0) {
+        ++frame;
+        wheel.advance(FRAME, [&](uint32_t id, TimerWheel::Tick) {
+            run.check += frame * id;
+            left--;
+        });
+    }
+    run.nsPerTimer = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / delays.size();
+    return run;
+}
+
+// The same clock arithmetic as TimerWheel, with the timers in a min-heap
+static Run runHeap(const std::vector<double>& delays) {
+    typedef std::pair<uint64_t, uint32_t> Entry; // Due tick, id
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+    Run run{ 0.0, 0 };
+    uint64_t now = 0, frame = 0;
+    double carry = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t id = 0; id < delays.size(); ++id) {
+        double ticks = std::ceil(delays[id] / MESSAGE_RESOLUTION + carry - 1e-9);
+        heap.push({ now + (ticks > 1.0 ? (uint64_t)ticks : 1), id });
+    }
+    while (!heap.empty()) {
+        ++frame;
+        carry += FRAME / MESSAGE_RESOLUTION;
+        uint64_t steps = (uint64_t)carry;
+        carry -= (double)steps;
+        now += steps;
+        while (!heap.empty() && heap.top().first <= now) {
+            run.check += frame * heap.top().second;
+            heap.pop();
+        }
+    }
+    run.nsPerTimer = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / delays.size();
+    return run;
+}
+
+// ========================
+// MESSAGE BOARD BURSTS
+// ========================
+struct Sent {
+    std::string text;
+    MessagePriority priority;
+};
+
+struct Burst {
+    const char* name;
+    int frames;                                          // Frames that send messages
+    std::function<void(int frame, std::vector<Sent>&)> send; // This frame's messages
+};
+
+// Plays a burst and then the frames until the board is empty. Every text
+// sent must have reached a line.
+static bool play(const Burst& burst) {
+    MessageBoard board;
+    std::set<std::string> sent, seen;
+    int frame = 0, redraws = 0, mostWaiting = 0, mostRepeats = 1;
+    uint64_t version = board.version();
+    std::vector<Sent> batch;
+    double showNs = 0.0, updateNs = 0.0;
+    long long shows = 0;
+
+    for (; frame < burst.frames || board.active(); ++frame) {
+        batch.clear();
+        if (frame < burst.frames) burst.send(frame, batch);
+        auto start = std::chrono::steady_clock::now();
+        for (const Sent& m : batch) board.show(m.text, MESSAGE_DURATION, m.priority);
+        auto shown = std::chrono::steady_clock::now();
+        board.update((float)FRAME);
+        showNs += std::chrono::duration<double, std::nano>(shown - start).count();
+        updateNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - shown).count();
+        shows += batch.size();
+        for (const Sent& m : batch) sent.insert(m.text);
+
+        if (board.version() != version) redraws++;
+        version = board.version();
+        for (int line = 0; line < board.lineCount(); ++line) {
+            std::string text = board.lineText(line);
+            size_t repeat = text.rfind(" (x");
+            if (repeat != std::string::npos) {
+                mostRepeats = std::max(mostRepeats, atoi(text.c_str() + repeat + 3));
+                text.resize(repeat);
+            }
+            seen.insert(text);
+        }
+        mostWaiting = std::max(mostWaiting, (int)board.waiting());
+    }
+
+    bool allSeen = seen == sent;
+    std::cout << std::left << std::setw(24) << burst.name << std::right << std::setw(4) << sent.size() << " texts, "
+              << std::setw(4) << seen.size() << " shown, " << std::setw(4) << redraws << " redraws, "
+              << std::setw(3) << mostWaiting << " waiting at most, x" << mostRepeats << " at most, empty after "
+              << std::fixed << std::setprecision(1) << frame * FRAME << " s; " << std::setprecision(0)
+              << showNs / std::max(shows, 1LL) << " ns/show, " << updateNs / frame << " ns/update"
+              << (allSeen ? "" : "  <-- MESSAGES LOST") << "\n";
+    return allSeen;
+}
+
+int main(int argc, char** argv) {
+    int most = argc > 1 ? atoi(argv[1]) : 1000000;
+
+    bool ok = true;
+    std::cout << "timers over 10 minutes, 60 FPS    wheel ns/timer   heap ns/timer\n";
+    for (int n = 1000; n <= most; n *= 10) {
+        std::mt19937 rng(n);
+        std::uniform_real_distribution<double> delay(0.0, 600.0);
+        std::vector<double> delays(n);
+        for (double& d : delays) d = delay(rng);
+
+        Run wheel = runWheel(delays);
+        Run heap = runHeap(delays);
+        bool same = wheel.check == heap.check;
+        ok = ok && same;
+        std::cout << std::setw(9) << n << std::setw(37) << std::fixed << std::setprecision(1) << wheel.nsPerTimer
+                  << std::setw(16) << heap.nsPerTimer << (same ? "" : "  <-- DIFFERENT EXPIRIES") << "\n";
+    }
+    std::cout << "\n";
+
+    const char* milestones[] = { "You've boke 10 already!", "Isn't this so much fun?", "Only 9,999,980 more to go!",
+                                 "Don't worry, your spacebar can handle a million presses... probably.",
+                                 "Fine, buy some grandmas to help you." };
+    const Burst bursts[] = {
+        { "a grandma every frame", 600, [](int, std::vector<Sent>& out) {
+              out.push_back({ "Grandma purchased!", MessagePriority::Low });
+          } },
+        { "all milestones at once", 1, [&](int, std::vector<Sent>& out) {
+              for (const char* m : milestones) out.push_back({ m, MessagePriority::High });
+          } },
+        { "purchases and a tip", 120, [](int f, std::vector<Sent>& out) {
+              out.push_back({ "Building " + std::to_string(f % 40) + " purchased!", MessagePriority::Low });
+              if (f == 30) out.push_back({ "Tip: try PRESTIGE (press R)", MessagePriority::Normal });
+          } },
+    };
+    for (const Burst& burst : bursts) ok = play(burst) && ok;
+    return ok ? 0 : 1;
+}
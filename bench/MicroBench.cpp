@@ -0,0 +1,303 @@
+// Microbenchmarks for the economy and rendering hot paths: rat updates across
+// the 50k-1M pie range, cats at high catnip, pies per second over growing
+// catalogs, number formatting, and the main and prestige shop screens.
+// Each case is timed in batches of about 5 ms and reports the median of 9;
+// results go out as JSON and can be compared against a stored baseline.
+// Build: g++ -std=c++17 -O2 bench/MicroBench.cpp core/GameCore.cpp core/ShopCatalog.cpp core/BigNumber.cpp core/Simulation.cpp core/MessageBoard.cpp core/FastForward.cpp core/FrameProfiler.cpp ui/ScreenBuffer.cpp ui/Render.cpp -o microbench
+// Usage: microbench [--json out.json] [--baseline bench/microbench_baseline.json] [--threshold percent] [--filter text]
+//        Exits with 1 if any case is slower than the baseline by more than the threshold (default 15%).
+//        To record a new baseline: microbench --json bench/microbench_baseline.json
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../ui/Render.h"
+
+using namespace piegame;
+
+const int SAMPLES = 9;
+const double SAMPLE_SECONDS = 0.005;
+const float FRAME = 1.0f / 30.0f;
+
+// Keeps a result alive so the optimizer cannot drop the work behind it
+template <typename T>
+static void keep(const T& value) {
+#if defined(__GNUC__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &value;
+#endif
+}
+
+// A case sets up its state, untimed, and returns what runs its operation
+// n times
+typedef std::function<void(long long n)> Runner;
+struct Case {
+    std::string name;
+    std::function<Runner()> prepare;
+};
+
+struct Result {
+    std::string name;
+    double nsPerOp;   // Median of the samples
+    double minNsPerOp;
+    long long iterations; // Per sample
+};
+
+static Result measure(const Case& c) {
+    using Clock = std::chrono::steady_clock;
+    Runner run = c.prepare();
+    auto timed = [&](long long n) {
+        auto start = Clock::now();
+        run(n);
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    };
+
+    // Grow the batch until it takes a measurable time, then size it to a sample
+    long long n = 1;
+    double seconds = timed(n);
+    while (seconds < SAMPLE_SECONDS / 10 && n < (1LL << 40)) {
+        n *= 10;
+        seconds = timed(n);
+    }
+    n = std::max(1LL, (long long)(n * SAMPLE_SECONDS / std::max(seconds, 1e-9)));
+
+    std::vector<double> perOp;
+    for (int s = 0; s < SAMPLES; ++s) perOp.push_back(timed(n) / n * 1e9);
+    std::sort(perOp.begin(), perOp.end());
+    return { c.name, perOp[SAMPLES / 2], perOp[0], n };
+}
+
+// ========================
+// CASES
+// ========================
+// A run past the intro with buildings bought and the shop listed
+static void prepareGame(Simulation& sim) {
+    sim.skipIntro();
+    sim.game.totalPies = 100000;
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < (int)sim.shopItems.size(); ++i) sim.apply({ ActionType::BuyItem, i });
+    }
+    sim.game.totalPies = 20000;
+    sim.step(FRAME);
+}
+
+// A catalog of n buildings, one of each bought
+static void buildCatalog(ShopList& shop, BuildingTable& table, int n) {
+    table.reset(0);
+    for (int i = 0; i < n; ++i) {
+        shop.push_back(std::make_unique<Building>("Building " + std::to_string(i), table, table.add(10 + i, 1 + i % 50)));
+        shop.back()->purchase();
+    }
+}
+
+static std::vector<Case> makeCases() {
+    std::vector<Case> cases;
+
+    for (int pies : { 50000, 100000, 250000, 500000, 1000000 }) {
+        cases.push_back({ "rats/tick/" + std::to_string(pies / 1000) + "k", [pies] {
+            return [pies, rats = RatSystem()](long long n) mutable {
+                CatSystem cats;
+                BigNumber pps(2000);
+                for (long long i = 0; i < n; ++i) {
+                    BigNumber total(pies);
+                    rats.tick(total, pps, cats);
+                    keep(total);
+                }
+            };
+        } });
+    }
+
+    for (int catnip : { 10, 30, 50 }) {
+        cases.push_back({ "cats/ratsEatenPerCat/catnip" + std::to_string(catnip), [catnip] {
+            return [catnip](long long n) {
+                CatSystem cats;
+                cats.milkPurchased = 20;
+                for (long long i = 0; i < n; ++i) {
+                    cats.catnipLevel = catnip + (int)(i & 1); // Not a constant the compiler can fold
+                    int eaten = cats.ratsEatenPerCat();
+                    keep(eaten);
+                }
+            };
+        } });
+    }
+
+    for (int size : { 9, 100, 1000, 10000 }) {
+        cases.push_back({ "shop/calculatePiesPerSecond/" + std::to_string(size), [size]() -> Runner {
+            auto shop = std::make_shared<ShopList>();
+            auto table = std::make_shared<BuildingTable>();
+            buildCatalog(*shop, *table, size);
+            return [shop, table](long long n) {
+                for (long long i = 0; i < n; ++i) {
+                    BigNumber pps = calculatePiesPerSecond(*shop);
+                    keep(pps);
+                }
+            };
+        } });
+    }
+
+    const std::pair<const char*, BigNumber> numbers[] = {
+        { "3digits", BigNumber(999) },
+        { "7digits", BigNumber(1234567) },
+        { "15digits", BigNumber(123456789012345LL) },
+        { "wide", BigNumber::fromDouble(1.5e40) },
+    };
+    for (const auto& number : numbers) {
+        BigNumber value = number.second;
+        cases.push_back({ std::string("format/formatWithCommas/") + number.first, [value] {
+            return [value](long long n) {
+                for (long long i = 0; i < n; ++i) {
+                    std::string text = formatWithCommas(value);
+                    keep(text);
+                }
+            };
+        } });
+    }
+
+    // The main screen as it is drawn most frames: the pie count has moved
+    struct Scene { const char* name; int pies; int milk; int catnip; };
+    for (Scene scene : { Scene{ "plain", 20000, 0, 0 }, Scene{ "rats", 300000, 0, 0 }, Scene{ "ratsAndCats", 300000, 3, 3 } }) {
+        cases.push_back({ std::string("render/frame/") + scene.name, [scene]() -> Runner {
+            auto sim = std::make_shared<Simulation>();
+            prepareGame(*sim);
+            sim->catSystem.milkPurchased = scene.milk;
+            sim->catSystem.catnipLevel = scene.catnip;
+            sim->game.totalPies = scene.pies;
+            sim->step(FRAME);
+            auto widgets = std::make_shared<MainScreenWidgets>();
+            auto screen = std::make_shared<ScreenBuffer>(CONSOLE_WIDTH, CONSOLE_HEIGHT);
+            return [sim, widgets, screen](long long n) {
+                PieAnimation anim;
+                for (long long i = 0; i < n; ++i) {
+                    sim->game.totalPies += (i & 1) ? -1 : 1;
+                    renderFrame(*screen, *widgets, *sim, anim);
+                    keep(*screen);
+                }
+            };
+        } });
+    }
+
+    cases.push_back({ "render/prestigeShop", []() -> Runner {
+        auto sim = std::make_shared<Simulation>();
+        sim->game.prestigeStars = 250;
+        sim->catSystem.milkPurchased = 4;
+        sim->catSystem.catnipLevel = 2;
+        auto screen = std::make_shared<ScreenBuffer>(CONSOLE_WIDTH, CONSOLE_HEIGHT);
+        return [sim, screen](long long n) {
+            for (long long i = 0; i < n; ++i) {
+                renderPrestigeShop(*screen, *sim);
+                keep(*screen);
+            }
+        };
+    } });
+
+    return cases;
+}
+
+// ========================
+// JSON
+// ========================
+static std::string toJson(const std::vector<Result>& results) {
+    std::ostringstream out;
+    out << "{\n  \"benchmark\": \"microbench\",\n  \"results\": [\n";
+    char line[256];
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        snprintf(line, sizeof(line), "    { \"name\": \"%s\", \"ns_per_op\": %.2f, \"min_ns_per_op\": %.2f, \"iterations\": %lld }%s\n",
+                 r.name.c_str(), r.nsPerOp, r.minNsPerOp, r.iterations, i + 1 < results.size() ? "," : "");
+        out << line;
+    }
+    out << "  ]\n}\n";
+    return out.str();
+}
+
+// Name -> ns_per_op from a file written by toJson()
+static std::map<std::string, double> readBaseline(const std::string& path) {
+    std::map<std::string, double> baseline;
+    std::ifstream in(path);
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    std::string text = buffer.str();
+
+    const std::string nameKey = "\"name\": \"", timeKey = "\"ns_per_op\": ";
+    size_t at = 0;
+    while ((at = text.find(nameKey, at)) != std::string::npos) {
+        size_t start = at + nameKey.size();
+        size_t end = text.find('"', start);
+        size_t time = text.find(timeKey, end);
+        if (end == std::string::npos || time == std::string::npos) break;
+        baseline[text.substr(start, end - start)] = strtod(text.c_str() + time + timeKey.size(), nullptr);
+        at = time;
+    }
+    return baseline;
+}
+
+int main(int argc, char** argv) {
+    std::string jsonPath, baselinePath, filter;
+    double threshold = 15.0;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string flag = argv[i];
+        if (flag == "--json") jsonPath = argv[i + 1];
+        else if (flag == "--baseline") baselinePath = argv[i + 1];
+        else if (flag == "--threshold") threshold = atof(argv[i + 1]);
+        else if (flag == "--filter") filter = argv[i + 1];
+        else {
+            std::cerr << "Unknown option " << flag << "\n";
+            return 2;
+        }
+    }
+
+    std::map<std::string, double> baseline;
+    if (!baselinePath.empty()) {
+        baseline = readBaseline(baselinePath);
+        if (baseline.empty()) {
+            std::cerr << "No results in " << baselinePath << "\n";
+            return 2;
+        }
+    }
+
+    std::vector<Result> results;
+    int regressions = 0;
+    printf("%-40s %12s %12s %9s\n", "case", "ns/op", "baseline", "change");
+    for (const Case& c : makeCases()) {
+        if (!filter.empty() && c.name.find(filter) == std::string::npos) continue;
+        Result r = measure(c);
+        results.push_back(r);
+
+        auto found = baseline.find(r.name);
+        if (found == baseline.end()) {
+            printf("%-40s %12.2f %12s\n", r.name.c_str(), r.nsPerOp, baseline.empty() ? "" : "new");
+            continue;
+        }
+        double change = (r.nsPerOp / found->second - 1.0) * 100.0;
+        bool regressed = change > threshold;
+        regressions += regressed;
+        printf("%-40s %12.2f %12.2f %+8.1f%%%s\n", r.name.c_str(), r.nsPerOp, found->second, change,
+               regressed ? "  REGRESSION" : "");
+    }
+
+    if (!jsonPath.empty()) {
+        std::ofstream out(jsonPath);
+        out << toJson(results);
+        if (!out) {
+            std::cerr << "Cannot write " << jsonPath << "\n";
+            return 2;
+        }
+    }
+    if (!baseline.empty()) {
+        printf("\n%d of %d cases more than %.0f%% slower than %s\n", regressions, (int)results.size(), threshold,
+               baselinePath.c_str());
+    }
+    return regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,87 @@
+// Times number formatting per call: the old to_string + string::insert
+// formatter against formatNumber() into a char buffer, and BigNumber's
+// fast-tier addition against a plain long long.
+// Build: g++ -std=c++17 -O2 bench/NumberBench.cpp core/BigNumber.cpp -o numberbench
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "../core/BigNumber.h"
+
+using namespace piegame;
+
+// The formatter the game used before, kept here for comparison
+static std::string oldFormatWithCommas(int value) {
+    std::string num = std::to_string(value);
+    int insertPosition = num.length() - 3;
+    while (insertPosition > 0) {
+        num.insert(insertPosition, ",");
+        insertPosition -= 3;
+    }
+    return num;
+}
+
+template <typename F>
+static double nanosPerCall(int calls, F f) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < calls; ++i) f(i);
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / calls;
+}
+
+int main() {
+    const int calls = 2000000;
+    const int values[] = { 7, 4321, 551184, 987654321 };
+    size_t sink = 0;
+    bool agree = true;
+
+    std::cout << std::left << std::setw(14) << "value" << std::setw(20) << "old (string) ns"
+              << std::setw(20) << "formatNumber ns" << "same text\n";
+    for (int v : values) {
+        double oldNs = nanosPerCall(calls, [&](int i) { sink += oldFormatWithCommas(v + (i & 1)).size(); });
+        char buffer[NUMBER_TEXT_MAX];
+        double newNs = nanosPerCall(calls, [&](int i) { sink += formatNumber(buffer, BigNumber(v + (i & 1))); });
+        bool same = oldFormatWithCommas(v) == std::string(buffer, formatNumber(buffer, BigNumber(v)));
+        agree = agree && same;
+        std::cout << std::setw(14) << v << std::setw(20) << oldNs << std::setw(20) << newNs << (same ? "yes" : "NO") << "\n";
+    }
+
+    // Short style, across both tiers
+    std::vector<BigNumber> samples = { 999, 1234, 1234567, 98765432100LL, BigNumber::fromDouble(4.2e20),
+                                       BigNumber::fromDouble(1.5e36), BigNumber::fromDouble(7.77e123) };
+    char buffer[NUMBER_TEXT_MAX];
+    double shortNs = nanosPerCall(calls, [&](int i) {
+        sink += formatNumber(buffer, samples[i % samples.size()], NumberStyle::Short);
+    });
+    std::cout << "\nshort style:  " << shortNs << " ns/call   ";
+    for (const BigNumber& s : samples) {
+        std::cout << std::string(buffer, formatNumber(buffer, s, NumberStyle::Short)) << "  ";
+    }
+    std::cout << "\n";
+
+    // The widget path: reusing one string, as the main screen does every frame
+    std::string line;
+    double appendNs = nanosPerCall(calls, [&](int i) {
+        line.clear();
+        line += "Pies: ";
+        appendNumber(line, BigNumber(551184 + i));
+        sink += line.size();
+    });
+    std::cout << "widget line:  " << appendNs << " ns/call (\"Pies: 551,184\" into a reused string)\n";
+
+    // Fast-tier arithmetic
+    long long plain = 0;
+    BigNumber big;
+    double plainNs = nanosPerCall(calls * 10, [&](int i) { plain += i & 7; });
+    double bigNs = nanosPerCall(calls * 10, [&](int i) { big += i & 7; });
+    std::cout << "add:          long long " << plainNs << " ns, BigNumber " << bigNs << " ns"
+              << (big == BigNumber(plain) ? "" : "  <-- totals differ") << "\n";
+
+    // What an int could not hold: a 1,000,000-rat swarm at 30,000 pies/sec each
+    BigNumber eating = BigNumber(999999) * BigNumber(30000) * BigNumber(1000000);
+    std::cout << "overflow:     999,999 rats x 30,000 x 1,000,000 = ";
+    std::cout << std::string(buffer, formatNumber(buffer, eating, NumberStyle::Short)) << "\n";
+
+    return agree && sink != 42 ? 0 : 1;
+}
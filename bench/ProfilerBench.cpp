@@ -0,0 +1,89 @@
+// Plays the tick benchmark's scripted player frame by frame with the frame
+// profiler attached, and prints the per-phase table before and after the
+// rats arrive. Also reports what a Scope costs, and checks that the [T]
+// overlay still fits on the screen.
+// Build: g++ -std=c++17 -O2 bench/ProfilerBench.cpp core/GameCore.cpp core/ShopCatalog.cpp core/BigNumber.cpp core/Simulation.cpp core/MessageBoard.cpp core/FastForward.cpp core/FrameProfiler.cpp ui/ScreenBuffer.cpp ui/Render.cpp -o profilerbench
+// Usage: profilerbench [frames]
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+
+#include "../ui/Render.h"
+
+using namespace piegame;
+
+const float FRAME = 1.0f / 30.0f;
+
+// The tick benchmark's player, timing its purchases like the front end does
+static void playFrame(Simulation& sim, FrameProfiler& timings) {
+    if (sim.intro.inIntro) {
+        if (sim.intro.unlockAvailable) sim.apply({ ActionType::UnlockBuildings });
+        else sim.apply({ ActionType::BakePie });
+        return;
+    }
+    sim.apply({ ActionType::BakePie });
+    for (int i = 0; i < (int)sim.shopItems.size(); ++i) {
+        FrameProfiler::Scope timed(&timings, FramePhase::Purchase);
+        if (sim.apply({ ActionType::BuyItem, i })) break;
+    }
+    if (sim.goalReached()) {
+        FrameProfiler::Scope timed(&timings, FramePhase::Prestige);
+        sim.apply({ ActionType::Prestige });
+        while (sim.apply({ ActionType::BuyPrestigeUpgrade, 0 })) {}
+        sim.apply({ ActionType::LeavePrestigeShop });
+    }
+}
+
+// Nanoseconds per Scope, with and without a profiler behind it
+static double scopeCost(FrameProfiler* profiler) {
+    const int repeats = 10000000;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r) {
+        FrameProfiler::Scope timed(profiler, FramePhase::Pies);
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / repeats * 1e9;
+}
+
+int main(int argc, char** argv) {
+    int frames = argc > 1 ? atoi(argv[1]) : 300000;
+
+    Simulation sim;
+    FrameProfiler timings;
+    sim.profiler = &timings;
+    PieAnimation anim;
+    MainScreenWidgets widgets;
+    ScreenBuffer screen(CONSOLE_WIDTH, CONSOLE_HEIGHT);
+    bool ratsSeen = false;
+    int tallest = 0;
+
+    for (int f = 0; f < frames; ++f) {
+        uint64_t frameStart = FrameProfiler::now();
+        playFrame(sim, timings);
+        sim.step(FRAME);
+        anim.update(FRAME);
+        if (!sim.intro.inIntro) {
+            {
+                FrameProfiler::Scope timed(&timings, FramePhase::Render);
+                renderFrame(screen, widgets, sim, anim, &timings);
+            }
+            if (screen.cursorRow() > tallest) tallest = screen.cursorRow();
+            FrameProfiler::Scope timed(&timings, FramePhase::Output);
+            screen.present();
+        }
+        timings.record(FramePhase::Frame, FrameProfiler::now() - frameStart);
+
+        if (!ratsSeen && sim.game.ratSystem.getTotalRats() > 0) {
+            ratsSeen = true;
+            std::cout << "Before the rats (" << f + 1 << " frames):\n" << timings.summary() << "\n";
+            timings.reset();
+        }
+    }
+
+    std::cout << (ratsSeen ? "With rats" : "No rats yet") << " (" << timings.frames() << " frames):\n"
+              << timings.summary() << "\n"
+              << "scope, no profiler:     " << scopeCost(nullptr) << " ns\n"
+              << "scope, profiling:       " << scopeCost(&timings) << " ns\n"
+              << "tallest frame:          " << tallest << " of " << CONSOLE_HEIGHT << " rows"
+              << (tallest <= CONSOLE_HEIGHT ? "\n" : " (overlay does not fit)\n");
+    return 0;
+}
@@ -0,0 +1,146 @@
+// Renders a scripted game into the screen buffer and reports how many bytes
+// each frame sends to the terminal, against printing the whole screen.
+// The diff stream is also replayed into a tiny terminal model to check that
+// it reproduces every frame exactly.
+// Build: g++ -std=c++17 -O2 bench/RenderBench.cpp core/GameCore.cpp core/ShopCatalog.cpp core/BigNumber.cpp core/Simulation.cpp core/MessageBoard.cpp core/FastForward.cpp core/FrameProfiler.cpp ui/ScreenBuffer.cpp ui/Render.cpp -o renderbench
+// Usage: renderbench [frames]
+#include <iostream>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "../ui/Render.h"
+
+using namespace piegame;
+
+// Just enough of an ANSI terminal to follow what ScreenBuffer emits
+struct TerminalModel {
+    int width, height;
+    std::vector<char> chars;
+    std::vector<int> colors;
+    int row = 0, col = 0, color = COLOR_DEFAULT;
+
+    TerminalModel(int w, int h) : width(w), height(h), chars(w * h, ' '), colors(w * h, COLOR_DEFAULT) {}
+
+    void feed(const std::string& bytes) {
+        for (size_t i = 0; i < bytes.size(); ++i) {
+            if (bytes[i] != '\x1b') {
+                if (row < height && col < width) {
+                    chars[row * width + col] = bytes[i];
+                    colors[row * width + col] = color;
+                }
+                col++;
+                continue;
+            }
+            // ESC [ params final
+            size_t j = i + 2;
+            std::vector<int> params(1, 0);
+            while (j < bytes.size() && (isdigit((unsigned char)bytes[j]) || bytes[j] == ';')) {
+                if (bytes[j] == ';') params.push_back(0);
+                else params.back() = params.back() * 10 + (bytes[j] - '0');
+                j++;
+            }
+            char final = bytes[j];
+            if (final == 'H') {
+                row = params[0] - 1;
+                col = params.size() > 1 ? params[1] - 1 : 0;
+            } else if (final == 'J') {
+                std::fill(chars.begin(), chars.end(), ' ');
+                std::fill(colors.begin(), colors.end(), (int)COLOR_DEFAULT);
+            } else if (final == 'm') {
+                int p = params[0];
+                if (p == 0) color = COLOR_DEFAULT;
+                else {
+                    int ansi = p >= 90 ? p - 90 : p - 30;
+                    color = (p >= 90 ? 8 : 0) | ((ansi & 1) ? 4 : 0) | (ansi & 2) | ((ansi & 4) ? 1 : 0);
+                }
+            }
+            i = j;
+        }
+    }
+};
+
+// The same scripted player as the tick benchmark, pressing a key every few frames
+static bool playFrame(Simulation& sim, PieAnimation& anim, int frame) {
+    if (frame % 6 != 0) return false;
+    if (sim.intro.inIntro) {
+        if (sim.intro.unlockAvailable) sim.apply({ ActionType::UnlockBuildings });
+        else sim.apply({ ActionType::BakePie });
+        anim.press();
+        return true;
+    }
+    sim.apply({ ActionType::BakePie });
+    anim.press();
+    for (int i = 0; i < (int)sim.shopItems.size(); ++i) {
+        if (sim.apply({ ActionType::BuyItem, i })) break;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int frames = argc > 1 ? atoi(argv[1]) : 20000;
+    const float frameTime = 1.0f / 30.0f;
+
+    Simulation sim;
+    PieAnimation anim;
+    MainScreenWidgets widgets;
+    ScreenBuffer screen(CONSOLE_WIDTH, CONSOLE_HEIGHT);
+    TerminalModel terminal(CONSOLE_WIDTH, CONSOLE_HEIGHT);
+
+    long long diffBytes = 0, fullBytes = 0, quietBytes = 0, quietFrames = 0;
+    int mismatches = 0;
+    double renderSeconds = 0.0;
+
+    for (int f = 0; f < frames; ++f) {
+        bool pressed = playFrame(sim, anim, f);
+        sim.step(frameTime);
+        anim.update(frameTime);
+
+        auto start = std::chrono::steady_clock::now();
+        if (sim.intro.inIntro) renderIntro(screen, sim);
+        else renderFrame(screen, widgets, sim, anim);
+        const std::string& bytes = screen.present();
+        renderSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        // What the old renderer printed: every used row padded to 80 columns
+        fullBytes += (long long)screen.cursorRow() * (CONSOLE_WIDTH + 1);
+        diffBytes += bytes.size();
+        if (!pressed && f % 6 > 1) {
+            quietBytes += bytes.size();
+            quietFrames++;
+        }
+
+        terminal.feed(bytes);
+        if (f % 97 == 0) {
+            // The screen's front grid is private; compare against a fresh full repaint
+            ScreenBuffer check(CONSOLE_WIDTH, CONSOLE_HEIGHT);
+            MainScreenWidgets freshWidgets;
+            TerminalModel fresh(CONSOLE_WIDTH, CONSOLE_HEIGHT);
+            if (sim.intro.inIntro) renderIntro(check, sim);
+            else renderFrame(check, freshWidgets, sim, anim);
+            fresh.feed(check.present());
+            if (fresh.chars != terminal.chars || fresh.colors != terminal.colors) mismatches++;
+        }
+    }
+
+    // A frame where nothing changed, as at a refresh rate faster than the game moves
+    const int repeats = 100000;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r) {
+        renderFrame(screen, widgets, sim, anim);
+        screen.present();
+    }
+    double unchangedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "frames:                 " << frames << "\n"
+              << "full repaint bytes/frame " << fullBytes / frames << "\n"
+              << "diff bytes/frame:       " << diffBytes / frames << "\n"
+              << "diff bytes, idle frames " << (quietFrames ? quietBytes / quietFrames : 0) << "\n"
+              << "render + diff:          " << renderSeconds / frames * 1e6 << " us/frame\n"
+              << "unchanged frame:        " << unchangedSeconds / repeats * 1e6 << " us/frame\n"
+              << "terminal mismatches:    " << mismatches << "\n";
+    return mismatches == 0 ? 0 : 1;
+}
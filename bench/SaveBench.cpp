@@ -0,0 +1,146 @@
+// Saves and loads a mid-game session and a batch checkpoint, checks that the
+// loaded games are the same games, and times both directions.
+// Build: g++ -std=c++17 -O2 bench/SaveBench.cpp core/GameCore.cpp core/ShopCatalog.cpp core/BigNumber.cpp core/Simulation.cpp core/MessageBoard.cpp core/BatchEnv.cpp core/SaveFile.cpp -o savebench
+// Usage: savebench [checkpointGames]
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../core/BatchEnv.h"
+#include "../core/SaveFile.h"
+
+using namespace piegame;
+
+// The TickBench player: bakes, buys the first affordable item, prestiges at the goal
+static void playTick(Simulation& sim) {
+    if (sim.intro.inIntro) {
+        if (sim.intro.unlockAvailable) sim.apply({ ActionType::UnlockBuildings });
+        else sim.apply({ ActionType::BakePie });
+        return;
+    }
+    sim.apply({ ActionType::BakePie });
+    for (int i = 0; i < (int)sim.shopItems.size(); ++i) {
+        if (sim.apply({ ActionType::BuyItem, i })) break;
+    }
+    if (sim.goalReached()) {
+        sim.apply({ ActionType::Prestige });
+        while (sim.apply({ ActionType::BuyPrestigeUpgrade, 0 })) {}
+        sim.apply({ ActionType::LeavePrestigeShop });
+    }
+}
+
+// Everything a save should bring back, as text
+static std::string describe(const Simulation& sim) {
+    std::ostringstream out;
+    out << sim.game << " pps " << sim.game.piesPerSecond << " baked " << sim.game.piesBakedThisRun
+        << " carry " << sim.game.pieCarry << "/" << sim.game.ratSystem.getEatenCarry()
+        << " unticked " << sim.game.untickedSeconds << " boost " << sim.prestigeShop.boostPercent
+        << " milk " << sim.catSystem.milkPurchased << " catnip " << sim.catSystem.catnipLevel
+        << " intro " << sim.intro.inIntro << " unlocked " << sim.game.prestigeUnlocked;
+    for (const auto& item : sim.shopItems) {
+        out << " | " << item->getCost() << "/" << item->getPiesPerSecond() << "/" << item->hasBeenVisible();
+    }
+    return out.str();
+}
+
+static double microsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    size_t checkpointGames = argc > 1 ? (size_t)atoll(argv[1]) : 100000;
+    const float frameTime = 1.0f / 30.0f;
+    const char* savePath = "savebench.sav";
+    const char* checkpointPath = "savebench.ckpt";
+    bool ok = true;
+
+    // A session a few prestiges in
+    Simulation played;
+    for (int t = 0; t < 400000; ++t) {
+        playTick(played);
+        played.step(frameTime);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    bool saved = saveGame(savePath, played);
+    double saveMicros = microsSince(start);
+
+    const int loads = 1000;
+    Simulation loaded;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < loads; ++i) saved = loadGame(savePath, loaded) && saved;
+    double loadMicros = microsSince(start) / loads;
+
+    // Same state, and it stays the same when both keep playing
+    bool same = describe(played) == describe(loaded);
+    for (int t = 0; t < 100000 && same; ++t) {
+        playTick(played);
+        played.step(frameTime);
+        playTick(loaded);
+        loaded.step(frameTime);
+    }
+    same = same && describe(played) == describe(loaded);
+    ok = ok && saved && same;
+    std::cout << "session save:       " << saveMicros << " us (write, fsync, rename)\n"
+              << "session load:       " << loadMicros << " us (map, check, restore)\n"
+              << "restored game:      " << (same ? "identical for 100000 more frames" : "DIFFERENT") << "\n";
+
+    // Batch checkpoint: every slot through store() -> SaveWriter -> SaveFile -> load()
+    BatchEnv batch(checkpointGames);
+    for (size_t g = 0; g < checkpointGames; ++g) {
+        batch.load(g, loaded);
+        for (int b = 0; b < batch.buildingTypes(); ++b) {
+            for (size_t n = (g >> (2 * b)) % 4; n > 0; --n) batch.buyBuilding(g, b);
+        }
+    }
+    for (int f = 0; f < 30; ++f) batch.step(frameTime);
+
+    Simulation scratch;
+    loadGame(savePath, scratch); // Same catalog and upgrades as the batch
+    start = std::chrono::steady_clock::now();
+    SaveWriter writer;
+    bool written = writer.begin(checkpointPath, checkpointGames, scratch.catalog());
+    for (size_t g = 0; g < checkpointGames && written; ++g) {
+        batch.store(g, scratch);
+        written = writer.add(scratch);
+    }
+    written = written && writer.commit();
+    double writeMicros = microsSince(start);
+
+    BatchEnv resumed(checkpointGames);
+    start = std::chrono::steady_clock::now();
+    SaveFile checkpoint;
+    bool read = checkpoint.open(checkpointPath) && checkpoint.games() == checkpointGames;
+    for (size_t g = 0; g < checkpointGames && read; ++g) {
+        read = checkpoint.restore(g, scratch);
+        resumed.load(g, scratch);
+    }
+    double readMicros = microsSince(start);
+    checkpoint.close();
+
+    size_t mismatches = 0;
+    for (size_t g = 0; g < checkpointGames; ++g) {
+        bool slotSame = batch.totalPies[g] == resumed.totalPies[g] && batch.pieCarry[g] == resumed.pieCarry[g] &&
+                        batch.eatenCarry[g] == resumed.eatenCarry[g] && batch.piesPerSecond[g] == resumed.piesPerSecond[g] &&
+                        batch.totalRats[g] == resumed.totalRats[g];
+        for (int b = 0; b < batch.buildingTypes(); ++b) {
+            slotSame = slotSame && batch.buildingCount[b][g] == resumed.buildingCount[b][g] &&
+                       batch.buildingMultiplier[b][g] == resumed.buildingMultiplier[b][g];
+        }
+        mismatches += !slotSame;
+    }
+    ok = ok && written && read && mismatches == 0;
+    size_t record = sizeof(SavedGame) + scratch.shopItems.size() * sizeof(SavedItem);
+    record = (record + alignof(SavedGame) - 1) / alignof(SavedGame) * alignof(SavedGame); // As padded on disk
+    double megabytes = (sizeof(SaveHeader) + checkpointGames * record) / 1e6;
+    std::cout << "checkpoint games:   " << checkpointGames << " (" << megabytes << " MB)\n"
+              << "checkpoint write:   " << writeMicros / 1000.0 << " ms\n"
+              << "checkpoint read:    " << readMicros / 1000.0 << " ms\n"
+              << "resumed slots:      " << (read && written ? checkpointGames - mismatches : 0) << "/" << checkpointGames << " identical\n";
+
+    std::remove(savePath);
+    std::remove(checkpointPath);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,116 @@
+// Leaves games idle at a few stages and compares the old fixed 33 ms beat
+// with the change-driven scheduler: how often each wakes up, and how many
+// of those wakeups actually changed the screen.
+// Build: g++ -std=c++17 -O2 bench/SchedulerBench.cpp core/GameCore.cpp core/ShopCatalog.cpp core/BigNumber.cpp core/Simulation.cpp core/MessageBoard.cpp core/FastForward.cpp core/FrameProfiler.cpp ui/ScreenBuffer.cpp ui/Render.cpp -o schedulerbench
+// Usage: schedulerbench [idleMinutes]
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstdlib>
+
+#include "../ui/Render.h"
+
+using namespace piegame;
+
+// The same limits as the console front end
+const float MIN_FRAME_SECONDS = 1.0f / 30.0f;
+const float MAX_WAIT_SECONDS = 1.0f;
+
+// The TickBench player, used to reach each stage
+static void playTick(Simulation& sim) {
+    if (sim.intro.inIntro) {
+        if (sim.intro.unlockAvailable) sim.apply({ ActionType::UnlockBuildings });
+        else sim.apply({ ActionType::BakePie });
+        return;
+    }
+    sim.apply({ ActionType::BakePie });
+    for (int i = 0; i < (int)sim.shopItems.size(); ++i) {
+        if (sim.apply({ ActionType::BuyItem, i })) break;
+    }
+}
+
+enum class Screen { Intro, Main, PrestigeShop };
+
+struct Idle {
+    long long wakeups = 0;
+    long long changed = 0; // Wakeups whose frame sent something to the terminal
+};
+
+// Idles `sim` on `shown` for `seconds`, waking on the old fixed beat or when
+// the scheduler says something is due
+static Idle idle(Simulation& sim, Screen shown, double seconds, bool scheduled) {
+    PieAnimation anim;
+    MainScreenWidgets widgets;
+    ScreenBuffer screen(CONSOLE_WIDTH, CONSOLE_HEIGHT);
+    auto draw = [&] {
+        if (shown == Screen::Intro) renderIntro(screen, sim);
+        else if (shown == Screen::PrestigeShop) renderPrestigeShop(screen, sim);
+        else renderFrame(screen, widgets, sim, anim);
+        return !screen.present().empty();
+    };
+    draw();
+
+    Idle result;
+    for (double t = 0.0; t < seconds;) {
+        float wait;
+        if (shown == Screen::PrestigeShop) {
+            wait = scheduled ? MAX_WAIT_SECONDS : 0.01f; // Was Sleep(10); now waits for a key
+        } else if (scheduled) {
+            wait = sim.secondsUntilChange();
+            if (shown == Screen::Main) wait = std::min(wait, anim.secondsUntilChange());
+            wait = std::min(std::max(wait, MIN_FRAME_SECONDS), MAX_WAIT_SECONDS);
+        } else {
+            wait = 1.0f / 30.0f; // Was Sleep(33)
+        }
+        if (shown != Screen::PrestigeShop) sim.step(wait);
+        anim.update(wait);
+        result.wakeups++;
+        result.changed += draw();
+        t += wait;
+    }
+    return result;
+}
+
+int main(int argc, char** argv) {
+    double seconds = (argc > 1 ? atof(argv[1]) : 10.0) * 60.0;
+
+    struct Stage {
+        const char* name;
+        Screen screen;
+        int warmupTicks; // TickBench player ticks before idling
+        bool oneGrandma; // Instead: skip the intro and buy a single grandma
+    };
+    const Stage stages[] = {
+        { "intro",          Screen::Intro,        0,      false },
+        { "one grandma",    Screen::Main,         0,      true },
+        { "first grandmas", Screen::Main,         1500,   false },
+        { "rat swarm",      Screen::Main,         120000, false },
+        { "prestige shop",  Screen::PrestigeShop, 120000, false },
+    };
+
+    std::cout << std::left << std::setw(16) << "stage" << std::setw(26) << "fixed beat: wakeups/s"
+              << std::setw(12) << "useful" << std::setw(24) << "scheduled: wakeups/s" << "useful\n";
+    for (const Stage& stage : stages) {
+        Idle runs[2];
+        for (int scheduled = 0; scheduled < 2; ++scheduled) {
+            Simulation sim;
+            if (stage.oneGrandma) {
+                sim.skipIntro();
+                sim.game.totalPies = 1000;
+                sim.apply({ ActionType::BuyItem, 0 });
+                sim.game.totalPies = 0;
+            }
+            for (int t = 0; t < stage.warmupTicks; ++t) {
+                playTick(sim);
+                sim.step(1.0f / 30.0f);
+            }
+            if (stage.screen == Screen::PrestigeShop) sim.apply({ ActionType::Prestige });
+            runs[scheduled] = idle(sim, stage.screen, seconds, scheduled != 0);
+        }
+        auto useful = [](const Idle& r) { return std::to_string(100 * r.changed / std::max(r.wakeups, 1LL)) + "%"; };
+        std::cout << std::setw(16) << stage.name
+                  << std::setw(26) << runs[0].wakeups / seconds << std::setw(12) << useful(runs[0])
+                  << std::setw(24) << runs[1].wakeups / seconds << useful(runs[1]) << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,51 @@
+// Runs the headless simulation as fast as possible and reports ticks per second.
+// Build: g++ -std=c++17 -O2 bench/TickBench.cpp core/GameCore.cpp core/ShopCatalog.cpp core/BigNumber.cpp core/Simulation.cpp core/MessageBoard.cpp -o tickbench
+// Usage: tickbench [ticks] [deltaTime]
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+
+#include "../core/Simulation.h"
+
+using namespace piegame;
+
+// A simple scripted player: bakes every tick, buys the first affordable shop
+// item, and prestiges (buying Boost%) whenever a run reaches the goal.
+static void playTick(Simulation& sim) {
+    if (sim.intro.inIntro) {
+        if (sim.intro.unlockAvailable) sim.apply({ ActionType::UnlockBuildings });
+        else sim.apply({ ActionType::BakePie });
+        return;
+    }
+    sim.apply({ ActionType::BakePie });
+    for (int i = 0; i < (int)sim.shopItems.size(); ++i) {
+        if (sim.apply({ ActionType::BuyItem, i })) break;
+    }
+    if (sim.goalReached()) {
+        sim.apply({ ActionType::Prestige });
+        while (sim.apply({ ActionType::BuyPrestigeUpgrade, 0 })) {}
+        sim.apply({ ActionType::LeavePrestigeShop });
+    }
+}
+
+int main(int argc, char** argv) {
+    long long ticks = argc > 1 ? atoll(argv[1]) : 10000000;
+    float deltaTime = argc > 2 ? (float)atof(argv[2]) : 1.0f / 30.0f;
+
+    Simulation sim;
+    auto start = std::chrono::steady_clock::now();
+    for (long long t = 0; t < ticks; ++t) {
+        playTick(sim);
+        sim.step(deltaTime);
+    }
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    std::cout << "ticks:          " << ticks << "\n"
+              << "deltaTime:      " << deltaTime << " s\n"
+              << "wall time:      " << seconds << " s\n"
+              << "ticks/second:   " << (long long)(ticks / seconds) << "\n"
+              << "game time:      " << ticks * deltaTime / 3600.0 << " h\n"
+              << "final state:\n" << sim.game << "\n";
+    return 0;
+}
@@ -0,0 +1,149 @@
+// Plays the same stretch of idle time at several frame rates, with uneven
+// frames, in long steps, and in one step far past the catch-up limit, and
+// checks that every run ends in the same state: pies and rats move in fixed
+// economy ticks, so how the time is cut into frames must not matter. The
+// same games also run in a BatchEnv at 240 FPS, which must agree too.
+// Build: g++ -std=c++17 -O2 bench/TimestepBench.cpp core/GameCore.cpp core/ShopCatalog.cpp core/BigNumber.cpp core/Simulation.cpp core/MessageBoard.cpp core/BatchEnv.cpp -o timestepbench
+// Usage: timestepbench [seconds]
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include "../core/BatchEnv.h"
+
+using namespace piegame;
+
+struct Scenario {
+    const char* name;
+    int pies;
+    int grandmas, bakeries, factories;
+    int milk;
+    int catnip;
+};
+
+static void setup(Simulation& sim, const Scenario& s) {
+    sim.startRun();
+    sim.skipIntro();
+    const int counts[] = { s.grandmas, s.bakeries, s.factories };
+    for (int slot = 0; slot < 3; ++slot) {
+        const Building& b = static_cast<const Building&>(*sim.shopItems[slot]);
+        sim.buildings.setRow(b.getRow(), counts[slot], 1.0f);
+    }
+    sim.game.piesPerSecond = sim.buildings.getTotalPiesPerSecond();
+    sim.game.totalPies = s.pies;
+    sim.catSystem.milkPurchased = s.milk;
+    sim.catSystem.catnipLevel = s.catnip;
+}
+
+// Everything the frame rate could have changed, as text
+static std::string describe(const Simulation& sim) {
+    std::ostringstream out;
+    out << "pies " << sim.game.totalPies << ", baked " << sim.game.piesBakedThisRun << ", rats "
+        << sim.game.ratSystem.getTotalRats() << ", carries " << sim.game.pieCarry << "/"
+        << sim.game.ratSystem.getEatenCarry();
+    return out.str();
+}
+
+// Steps sim for `seconds` in frames from nextFrame(), the last one cut to fit
+static long long play(Simulation& sim, double seconds, const std::function<float()>& nextFrame) {
+    double clock = 0.0;
+    long long frames = 0;
+    while (clock < seconds) {
+        float dt = nextFrame();
+        if (clock + dt > seconds) dt = (float)(seconds - clock);
+        sim.step(dt);
+        clock += dt;
+        ++frames;
+    }
+    return frames;
+}
+
+int main(int argc, char** argv) {
+    double seconds = argc > 1 ? atof(argv[1]) : 3600.0;
+    seconds += TICK_SECONDS / 2; // Ends mid-tick, so float rounding cannot move the last tick
+
+    const Scenario scenarios[] = {
+        { "grandmas only",    100,  40,  0, 0,   0,  0 },
+        { "crossing rats",  30000,  60, 40, 20,  0,  0 },
+        { "rats win",      800000,  20,  0, 0,   0,  0 },
+        { "cats help",      60000, 100, 60, 60, 200, 10 },
+    };
+
+    struct Schedule {
+        const char* name;
+        std::function<float()> frame;
+    };
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> uneven(1.0f / 250.0f, 1.0f / 20.0f);
+    const Schedule schedules[] = {
+        { "30 FPS",          [] { return 1.0f / 30.0f; } },
+        { "60 FPS",          [] { return 1.0f / 60.0f; } },
+        { "144 FPS",         [] { return 1.0f / 144.0f; } },
+        { "240 FPS",         [] { return 1.0f / 240.0f; } },
+        { "20-250 FPS",      [&] { return uneven(rng); } },
+        { "10 s steps",      [] { return 10.0f; } },
+    };
+
+    bool allSame = true;
+    for (const Scenario& s : scenarios) {
+        std::cout << s.name << " (" << std::fixed << std::setprecision(0) << seconds << " s):\n";
+        std::string reference;
+        for (const Schedule& schedule : schedules) {
+            Simulation sim;
+            setup(sim, s);
+            auto start = std::chrono::steady_clock::now();
+            long long frames = play(sim, seconds, schedule.frame);
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            std::string state = describe(sim);
+            if (reference.empty()) reference = state;
+            bool same = state == reference;
+            allSame = allSame && same;
+            std::cout << "  " << std::left << std::setw(16) << schedule.name << std::right << std::setw(10) << frames
+                      << " frames " << std::setprecision(2) << std::setw(9) << ms << " ms  " << state
+                      << (same ? "" : "  <-- DIFFERENT") << "\n";
+        }
+
+        // One step for the whole stretch: it runs MAX_TICKS_PER_STEP ticks,
+        // the rest come with the (empty) frames after it
+        Simulation sim;
+        setup(sim, s);
+        sim.step((float)seconds);
+        int catchUp = 0;
+        while (sim.game.untickedSeconds >= TICK_SECONDS - TICK_SLACK) {
+            sim.step(0.0f);
+            ++catchUp;
+        }
+        std::string state = describe(sim);
+        bool same = state == reference;
+        allSame = allSame && same;
+        std::cout << "  " << std::left << std::setw(16) << "one step" << std::right << std::setw(10) << catchUp + 1
+                  << " frames " << std::setw(9) << "" << "     " << state << (same ? "" : "  <-- DIFFERENT") << "\n";
+
+        // The batch kernels at 240 FPS, from the same start
+        Simulation start;
+        setup(start, s);
+        BatchEnv batch(1);
+        batch.load(0, start);
+        double clock = 0.0;
+        while (clock < seconds) {
+            float dt = std::min(1.0f / 240.0f, (float)(seconds - clock));
+            batch.step(dt);
+            clock += dt;
+        }
+        batch.store(0, start);
+        state = describe(start);
+        same = state == reference;
+        allSame = allSame && same;
+        std::cout << "  " << std::left << std::setw(16) << "BatchEnv 240" << std::right << std::setw(10) << ""
+                  << "        " << std::setw(9) << "" << "     " << state << (same ? "" : "  <-- DIFFERENT") << "\n\n";
+    }
+    std::cout << (allSame ? "every schedule ends in the same state\n" : "SCHEDULES DISAGREE\n");
+    return allSame ? 0 : 1;
+}
@@ -0,0 +1,133 @@
+#include "AutoBuyer.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace piegame {
+
+namespace {
+
+// How many buildings, the next one first, cost at most `price` each. Unit k
+// costs baseCost + k * baseCost / 2 (rounded down), which stays within the
+// price while k <= (2 * (price - baseCost) + 1) / baseCost.
+long long unitsPricedUpTo(int baseCost, long long owned, const BigNumber& price) {
+    double room = price.toDouble() - baseCost;
+    if (room < 0.0) return 0;
+    double last = room < 1e15 ? (double)((2 * (long long)room + 1) / baseCost) : (2.0 * room + 1.0) / baseCost;
+    return last < (double)INT_MAX ? std::max(0LL, (long long)last - owned + 1) : INT_MAX;
+}
+
+} // namespace
+
+void AutoBuyer::setPolicy(const AutoBuyPolicy& policy) {
+    rules = policy;
+    watched = nullptr; // Start over on the next call
+}
+
+bool AutoBuyer::next(const Simulation& sim, Action& action) {
+    if (&sim != watched || sim.shopGeneration() != generation) restart(sim);
+    settle(sim);
+
+    const BigNumber& pies = sim.game.totalPies;
+    while (!queue.empty() && queue.front().first <= pies) {
+        int slot = pop().second;
+        const ShopItem& item = *sim.shopItems[slot];
+        bool building = sim.catalog()[slot].kind == ShopKind::Building;
+
+        // The player bought it (or another of it) since it was queued
+        bool stale = building ? (rules.buildingLimit > 0 && static_cast<const Building&>(item).getCount() >= rules.buildingLimit)
+                              : static_cast<const Upgrade&>(item).isPurchased();
+        if (stale || item.getCost() + rules.reserve > pies) {
+            watch(sim, slot);
+            continue;
+        }
+
+        action = { ActionType::BuyItem, slot };
+        if (building) {
+            // One unit at a time, each then queued at its new price, would
+            // keep this building on top while it stays the cheapest: buy
+            // that run at once
+            const Building& b = static_cast<const Building&>(item);
+            long long owned = b.getCount();
+            long long count = affordableBuildings(b.getBaseCost(), owned, pies - rules.reserve);
+            if (rules.buildingLimit > 0) count = std::min(count, rules.buildingLimit - owned);
+            if (!queue.empty()) {
+                BigNumber price = queue.front().first - rules.reserve;
+                if (queue.front().second < slot) price -= 1; // Ties go to the earlier slot
+                count = std::min(count, unitsPricedUpTo(b.getBaseCost(), owned, price));
+            }
+            action.count = (int)std::max(count, 1LL);
+        }
+        handedOut = slot;
+        return true;
+    }
+    return false;
+}
+
+bool AutoBuyer::nextThreshold(const Simulation& sim, BigNumber& pies) {
+    if (&sim != watched || sim.shopGeneration() != generation) restart(sim);
+    settle(sim);
+    if (queue.empty()) return false;
+    pies = queue.front().first;
+    return true;
+}
+
+void AutoBuyer::restart(const Simulation& sim) {
+    watched = &sim;
+    generation = sim.shopGeneration();
+    queue.clear();
+    handedOut = -1;
+    for (int slot = 0; slot < (int)sim.shopItems.size(); ++slot) {
+        bool bought = sim.catalog()[slot].kind == ShopKind::Upgrade &&
+                      static_cast<const Upgrade&>(*sim.shopItems[slot]).isPurchased();
+        if (!bought) watch(sim, slot);
+    }
+}
+
+// The last action was applied or turned down: queue its item again either way
+void AutoBuyer::settle(const Simulation& sim) {
+    if (handedOut < 0) return;
+    int slot = handedOut;
+    handedOut = -1;
+    watch(sim, slot);
+}
+
+// Queues `slot` at the pies its next purchase needs, or lets it go: a
+// building at its limit, a bought upgrade (whose dependents are queued
+// instead), an upgrade still waiting for its prerequisite
+void AutoBuyer::watch(const Simulation& sim, int slot) {
+    const CatalogEntry& entry = sim.catalog()[slot];
+    const ShopItem& item = *sim.shopItems[slot];
+    if (entry.kind == ShopKind::Building) {
+        const Building& b = static_cast<const Building&>(item);
+        if (!rules.buildings || (rules.buildingLimit > 0 && b.getCount() >= rules.buildingLimit)) return;
+        push(b.getCost() + rules.reserve, slot);
+        return;
+    }
+
+    if (!rules.upgrades) return;
+    if (static_cast<const Upgrade&>(item).isPurchased()) {
+        for (const int* d = sim.catalog().dependentsBegin(slot); d != sim.catalog().dependentsEnd(slot); ++d) {
+            watch(sim, *d);
+        }
+        return;
+    }
+    if (entry.prerequisite >= 0 && !static_cast<const Upgrade&>(*sim.shopItems[entry.prerequisite]).isPurchased()) {
+        return; // Queued when the prerequisite comes up bought
+    }
+    push(item.getCost() + rules.reserve, slot);
+}
+
+void AutoBuyer::push(const BigNumber& pies, int slot) {
+    queue.push_back({ pies, slot });
+    std::push_heap(queue.begin(), queue.end(), std::greater<Entry>());
+}
+
+AutoBuyer::Entry AutoBuyer::pop() {
+    std::pop_heap(queue.begin(), queue.end(), std::greater<Entry>());
+    Entry top = queue.back();
+    queue.pop_back();
+    return top;
+}
+
+} // End of namespace piegame
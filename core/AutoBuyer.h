@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Simulation.h"
+
+#include <utility>
+#include <vector>
+
+namespace piegame {
+
+// ========================
+// AUTOBUYER
+// ========================
+// Buys shop items for an idle player by a policy, cheapest first. Every
+// candidate waits in a min-heap keyed on the pie count that pays for it (its
+// price plus the reserve), so a frame in which nothing becomes affordable
+// costs one comparison, whatever the size of the catalog.
+//
+// Purchases come out as Actions for the caller to apply (through the journal
+// in the front end, so a replay buys the same things). The player may buy
+// from the same shop: a building whose price went up meanwhile goes back in
+// the heap at its new price when it comes up, and a bought upgrade is
+// dropped then, letting the upgrades that needed it in.
+struct AutoBuyPolicy {
+    bool buildings = true;
+    bool upgrades = true;  // Only once their prerequisite is bought
+    int buildingLimit = 0; // Stop at this many of each building (0: no limit)
+    BigNumber reserve;     // Pies to keep back after every purchase
+};
+
+class AutoBuyer {
+public:
+    explicit AutoBuyer(const AutoBuyPolicy& policy = AutoBuyPolicy()) : rules(policy) {}
+
+    const AutoBuyPolicy& policy() const { return rules; }
+    void setPolicy(const AutoBuyPolicy& policy);
+
+    // The next purchase the policy makes in sim, if any. Consecutive units
+    // of a building come as one bulk action, up to where another candidate
+    // gets cheaper. Apply each one until either side says no:
+    //   while (buyer.next(sim, action) && sim.apply(action)) {}
+    bool next(const Simulation& sim, Action& action);
+
+    // Pies the next candidate waits for (what the front end can sleep
+    // towards), or false if nothing is left to buy
+    bool nextThreshold(const Simulation& sim, BigNumber& pies);
+
+private:
+    typedef std::pair<BigNumber, int> Entry; // Pies needed, shop slot
+
+    AutoBuyPolicy rules;
+    const Simulation* watched = nullptr;
+    unsigned generation = 0;
+    std::vector<Entry> queue; // Min-heap
+    int handedOut = -1;       // Slot of the last action, until it is settled
+
+    void restart(const Simulation& sim);
+    void settle(const Simulation& sim);
+    void watch(const Simulation& sim, int slot);
+    void push(const BigNumber& pies, int slot);
+    Entry pop();
+};
+
+} // End of namespace piegame
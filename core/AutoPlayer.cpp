@@ -0,0 +1,158 @@
+#include "AutoPlayer.h"
+#include "FastForward.h"
+#include "PrestigeCatalog.h"
+
+#include <cmath>
+#include <limits>
+
+namespace piegame {
+
+namespace {
+
+const double FRAME = TICK_SECONDS;
+const double CLICK_SECONDS = 1.0;      // Clicking is played in one-second bursts of frames
+const double CLICKS_WORTHWHILE = 5.0;  // Keep clicking until buildings beat this many clicks' worth
+const double MAX_IDLE_CHUNK = 3600.0;  // Look at the shop again at least once per idle hour
+const int MILK_SLOT = PrestigeCatalog::slotOf<MilkUpgrade>();
+const int CATNIP_SLOT = PrestigeCatalog::slotOf<CatnipUpgrade>();
+const double NEVER = std::numeric_limits<double>::infinity();
+const BigNumber ANY_PRICE = BigNumber::fromDouble(std::numeric_limits<double>::max()); // canPurchase() = not owned yet
+
+// Plays frames for `seconds`, pressing SPACE at the profile's click rate
+void clickFor(Simulation& sim, double seconds, double clicksPerSecond, double& clickCredit, double& clock) {
+    int frames = (int)std::ceil(seconds / FRAME);
+    for (int f = 0; f < frames && !sim.goalReached(); ++f) {
+        clickCredit += clicksPerSecond * FRAME;
+        while (clickCredit >= 1.0) {
+            sim.apply({ ActionType::BakePie });
+            clickCredit -= 1.0;
+        }
+        sim.step((float)FRAME);
+        clock += FRAME;
+    }
+}
+
+// Spends all stars on cats: whichever of Milk and Catnip is cheaper first
+void spendStars(Simulation& sim) {
+    while (true) {
+        int first = MilkUpgrade::cost(sim.prestigeShop, sim.catSystem) <= CatnipUpgrade::cost(sim.prestigeShop, sim.catSystem)
+                        ? MILK_SLOT : CATNIP_SLOT;
+        int second = first == MILK_SLOT ? CATNIP_SLOT : MILK_SLOT;
+        if (!sim.apply({ ActionType::BuyPrestigeUpgrade, first }) &&
+            !sim.apply({ ActionType::BuyPrestigeUpgrade, second })) {
+            break;
+        }
+    }
+}
+
+} // namespace
+
+int chooseShopItem(const Simulation& sim, BuyOrder order, double maxPaybackSeconds) {
+    int best = -1;
+    double bestScore = -std::numeric_limits<double>::infinity();
+    double rateNow = netPieRate(sim, sim.game.piesPerSecond);
+    for (int i = 0; i < (int)sim.shopItems.size(); ++i) {
+        const ShopItem& item = *sim.shopItems[i];
+        // Only what the player can see, and not upgrades already owned
+        if (!item.hasBeenVisible() && !item.isVisible(sim.game.totalPies)) continue;
+        if (!item.canPurchase(ANY_PRICE)) continue;
+
+        // Skip anything that would only feed the rats or takes too long to earn back
+        BigNumber gain = item.getPiesPerSecondGain();
+        double netGain = netPieRate(sim, sim.game.piesPerSecond + gain) - rateNow;
+        if (gain <= 0 || netGain <= 0.0) continue;
+        double cost = item.getCost().toDouble();
+        if (cost / netGain > maxPaybackSeconds) continue;
+
+        double score;
+        if (order == BuyOrder::CheapestFirst) {
+            score = -cost;
+        } else {
+            score = netGain / cost;
+        }
+        if (score > bestScore) {
+            bestScore = score;
+            best = i;
+        }
+    }
+    return best;
+}
+
+GameResult playGame(Simulation& sim, const PlayerProfile& profile) {
+    GameResult result;
+    double clock = 0.0;
+    double clickCredit = 0.0;
+
+    // Intro: SPACE until [U] is offered, then unlock the buildings
+    while (sim.intro.inIntro && clock < profile.giveUpSeconds) {
+        if (sim.intro.unlockAvailable && sim.apply({ ActionType::UnlockBuildings })) break;
+        clickFor(sim, CLICK_SECONDS, profile.clicksPerSecond, clickCredit, clock);
+    }
+
+    while (!sim.goalReached() && clock < profile.giveUpSeconds) {
+        bool clicking = sim.game.piesPerSecond.toDouble() < CLICKS_WORTHWHILE * profile.clicksPerSecond;
+        if (clicking) {
+            // Early on everything pays for itself and clicking beats waiting
+            int pick = chooseShopItem(sim, profile.buyOrder);
+            if (pick >= 0 && sim.apply({ ActionType::BuyItem, pick })) {
+                result.purchases++;
+                continue;
+            }
+            clickFor(sim, CLICK_SECONDS, profile.clicksPerSecond, clickCredit, clock);
+            continue;
+        }
+
+        // Only buy what earns its price back before the goal (or soon, if the goal is out of reach)
+        double toGoal = timeUntilPies(sim, GOAL_PIES);
+        double horizon = std::isinf(toGoal) ? profile.slowSeconds : toGoal;
+        int pick = chooseShopItem(sim, profile.buyOrder, horizon);
+        double itemCost = pick >= 0 ? sim.shopItems[pick]->getCost().toDouble() : (double)GOAL_PIES;
+        double toItem = pick >= 0 ? timeUntilPies(sim, itemCost) : NEVER;
+        if (pick >= 0 && std::isinf(toItem)) {
+            // The rats keep the favourite out of reach: settle for the cheapest item
+            pick = chooseShopItem(sim, BuyOrder::CheapestFirst, horizon);
+            itemCost = pick >= 0 ? sim.shopItems[pick]->getCost().toDouble() : (double)GOAL_PIES;
+            toItem = pick >= 0 ? timeUntilPies(sim, itemCost) : NEVER;
+        }
+
+        bool stalled = std::isinf(toGoal) && std::isinf(toItem);
+        bool slow = std::min(toItem, toGoal) > profile.slowSeconds;
+        bool wantsPrestige = (profile.prestigeRule == PrestigeRule::WhenStalled && stalled) ||
+                             (profile.prestigeRule == PrestigeRule::WhenSlow && slow);
+        if (wantsPrestige && sim.apply({ ActionType::Prestige })) {
+            result.prestiges++;
+            spendStars(sim);
+            sim.apply({ ActionType::LeavePrestigeShop });
+            continue;
+        }
+        if (stalled) {
+            clock = profile.giveUpSeconds; // Nothing left to buy or wait for
+            break;
+        }
+
+        if (pick >= 0 && sim.apply({ ActionType::BuyItem, pick })) {
+            // A purchase is a key press too: the player cannot buy faster than they click
+            result.purchases++;
+            clock += fastForward(sim, 1.0 / profile.clicksPerSecond).elapsed;
+            continue;
+        }
+
+        // Idle until the next thing we want
+        double wait = std::min(toItem, toGoal);
+        double chunk = std::min(std::min(wait + FRAME, MAX_IDLE_CHUNK), profile.giveUpSeconds - clock);
+        double stopAt = toItem <= toGoal ? itemCost : (double)GOAL_PIES;
+        FastForwardResult skipped = fastForward(sim, chunk, stopAt);
+        clock += skipped.elapsed;
+        if (skipped.elapsed < FRAME) {
+            // Rounding left us a pie short: play one frame to get past it
+            sim.step((float)FRAME);
+            clock += FRAME;
+        }
+    }
+
+    result.reachedGoal = sim.goalReached();
+    result.seconds = clock;
+    return result;
+}
+
+} // End of namespace piegame
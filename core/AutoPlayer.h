@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Simulation.h"
+
+#include <limits>
+
+namespace piegame {
+
+// ========================
+// AUTO PLAYER
+// ========================
+// A scripted player for batch tools: clicks through the intro, buys shop items
+// by a fixed rule, prestiges by a fixed rule and spends stars on cats until
+// the 1,000,000 pie goal is reached. Idle stretches go through fastForward(),
+// so a game costs microseconds per decision instead of one step per frame.
+
+// Which shop item to buy next
+enum class BuyOrder {
+    CheapestFirst,  // Cheapest visible item
+    BestPpsPerCost  // Largest pies/sec gain per pie spent
+};
+
+// When to reset for prestige stars
+enum class PrestigeRule {
+    Never,       // Keep waiting (stalls for good once the rats keep up)
+    WhenStalled, // Only when neither the next buy nor the goal can ever be reached
+    WhenSlow     // Also when both are further away than slowSeconds
+};
+
+struct PlayerProfile {
+    BuyOrder buyOrder = BuyOrder::BestPpsPerCost;
+    PrestigeRule prestigeRule = PrestigeRule::WhenSlow;
+    double clicksPerSecond = 6.0;      // How fast the player mashes SPACE
+    double slowSeconds = 1800.0;       // "Too slow" for PrestigeRule::WhenSlow
+    double giveUpSeconds = 30 * 86400; // Game time before a run counts as unfinished
+};
+
+struct GameResult {
+    bool reachedGoal = false;
+    double seconds = 0.0; // Game time played, intro included
+    int prestiges = 0;
+    int purchases = 0;
+};
+
+// Shop slot to buy next, or -1 if nothing on offer is worth it. Items that
+// would only feed the rats, or need more than maxPaybackSeconds of their
+// extra production to earn back their price, are skipped.
+int chooseShopItem(const Simulation& sim, BuyOrder order,
+                   double maxPaybackSeconds = std::numeric_limits<double>::infinity());
+
+// Plays sim from the start of a run until the goal (or giveUpSeconds)
+GameResult playGame(Simulation& sim, const PlayerProfile& profile);
+
+} // End of namespace piegame
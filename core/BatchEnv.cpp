@@ -0,0 +1,296 @@
+#include "BatchEnv.h"
+
+#include <climits>
+#include <cstdint>
+#include <cstring>
+
+namespace piegame {
+
+namespace {
+
+// ========================
+// VECTOR-FRIENDLY MATH
+// ========================
+// libm's pow() is a call the compiler cannot vectorize, so the kernels use
+// pow(x, e) = exp2(e * log2(x)) built from bit tricks and polynomials that
+// only need adds, multiplies and 64-bit integer shifts. For the ranges used
+// here (x in [1, 50000], e in [0, 2]) the relative error stays below 1e-12,
+// so the int truncations of the scalar code come out the same.
+
+inline uint64_t bitsOf(double x) {
+    uint64_t bits;
+    std::memcpy(&bits, &x, sizeof bits);
+    return bits;
+}
+
+inline double fromBits(uint64_t bits) {
+    double x;
+    std::memcpy(&x, &bits, sizeof x);
+    return x;
+}
+
+// log2 of a positive, normal x
+inline double vecLog2(double x) {
+    const double TWO_POW_52 = 4503599627370496.0;
+    const uint64_t bits = bitsOf(x);
+    // Exponent as a double without an int64 -> double conversion (SSE2 has none)
+    double exponent = fromBits((bits >> 52) | 0x4330000000000000ull) - TWO_POW_52 - 1023.0;
+    double m = fromBits((bits & 0x000FFFFFFFFFFFFFull) | 0x3FF0000000000000ull); // [1, 2)
+    bool high = m > 1.4142135623730951;
+    m *= high ? 0.5 : 1.0;
+    exponent += high ? 1.0 : 0.0;
+
+    // ln(m) = 2 atanh(t) with t = (m - 1) / (m + 1), |t| < 0.172
+    double t = (m - 1.0) / (m + 1.0);
+    double t2 = t * t;
+    double series = 2.0 / 13.0;
+    series = series * t2 + 2.0 / 11.0;
+    series = series * t2 + 2.0 / 9.0;
+    series = series * t2 + 2.0 / 7.0;
+    series = series * t2 + 2.0 / 5.0;
+    series = series * t2 + 2.0 / 3.0;
+    series = series * t2 + 2.0;
+    return exponent + t * series * 1.4426950408889634;
+}
+
+// 2^y for y in [-1000, 1000]
+inline double vecExp2(double y) {
+    const double ROUNDER = 6755399441055744.0; // 1.5 * 2^52: adding it rounds to an integer
+    double shifted = y + ROUNDER;
+    double n = shifted - ROUNDER;
+    double g = (y - n) * 0.6931471805599453; // |g| <= ln(2) / 2
+
+    // e^g, Taylor to degree 11
+    double p = 1.0 / 39916800.0;
+    p = p * g + 1.0 / 3628800.0;
+    p = p * g + 1.0 / 362880.0;
+    p = p * g + 1.0 / 40320.0;
+    p = p * g + 1.0 / 5040.0;
+    p = p * g + 1.0 / 720.0;
+    p = p * g + 1.0 / 120.0;
+    p = p * g + 1.0 / 24.0;
+    p = p * g + 1.0 / 6.0;
+    p = p * g + 0.5;
+    p = p * g + 1.0;
+    p = p * g + 1.0;
+
+    // 2^n straight into the exponent bits (n sits in the low bits of `shifted`)
+    uint64_t scale = (bitsOf(shifted) - bitsOf(ROUNDER) + 1023) << 52;
+    return p * fromBits(scale);
+}
+
+// x^e for x >= 1
+inline double vecPow(double x, double e) {
+    return vecExp2(e * vecLog2(x));
+}
+
+// One tick of Simulation::tickGame's economy for n games: production, then
+// RatSystem::tick. Every array is its own allocation (__restrict tells the
+// compiler so, which it needs before it will vectorize).
+void tickKernel(size_t n, const RatSystem& rules,
+                int* __restrict pies, int* __restrict baked, int* __restrict pieCarry,
+                int* __restrict rats, int* __restrict eating, int* __restrict eatenCarry,
+                const int* __restrict pps, const int* __restrict catsEat) {
+    const int threshold = rules.getThreshold();
+    const double maxRats = rules.getMaxRats();
+    const double eatRate = rules.getEatRate();
+    const double growth = rules.rules().growth;
+    const double growthBoost = rules.rules().growthBoost;
+
+    for (size_t g = 0; g < n; ++g) {
+        // Production (tickShare)
+        int due = pieCarry[g] + pps[g];
+        int whole = due / TICKS_PER_SECOND;
+        int total = pies[g] + whole;
+        baked[g] += whole;
+        pieCarry[g] = due - whole * TICKS_PER_SECOND;
+
+        // Rats, computed for every game and masked where there are none. The
+        // clamps are done on ints: clamping doubles lets the compiler split
+        // the loop into branches it can no longer vectorize.
+        bool infested = total >= threshold;
+        double progress = std::min(total, RAT_PROGRESS_PIES) / (double)RAT_PROGRESS_PIES;
+        double exponent = growth + growthBoost * (progress * progress);
+        double base = std::max(total, threshold) / (double)threshold;
+        int ratCount = int(std::min(3 * vecPow(base, exponent), maxRats));
+        int eatenByCats = catsEat[g];
+        ratCount -= eatenByCats < ratCount ? eatenByCats : ratCount;
+
+        float single = float(eatRate + (0.005f + 0.025f * (progress * progress * progress)) * pps[g]);
+        int perSecond = int(ratCount * single);
+        int bites = eatenCarry[g] + perSecond;
+        int wanted = bites / TICKS_PER_SECOND;
+        bool enough = wanted <= total;
+
+        pies[g] = infested ? total - (enough ? wanted : total) : total;
+        rats[g] = infested ? ratCount : 0;
+        eating[g] = infested ? perSecond : 0;
+        eatenCarry[g] = infested && enough ? bites - wanted * TICKS_PER_SECOND : 0;
+    }
+}
+
+} // namespace
+
+// ========================
+// SETUP AND PURCHASES
+// ========================
+BatchEnv::BatchEnv(size_t games) : gameCount(games) {
+    Simulation fresh;
+    for (const auto& item : fresh.shopItems) {
+        if (const Building* b = dynamic_cast<const Building*>(item.get())) {
+            buildingBaseCost.push_back(b->getBaseCost());
+            buildingBasePps.push_back(b->getBasePiesPerSecond());
+        }
+    }
+
+    totalPies.assign(games, 0);
+    piesPerSecond.assign(games, 0);
+    piesBakedThisRun.assign(games, 0);
+    pieCarry.assign(games, 0);
+    totalRats.assign(games, 0);
+    ratsEating.assign(games, 0);
+    eatenCarry.assign(games, 0);
+    milkPurchased.assign(games, 0);
+    catnipLevel.assign(games, 0);
+    boostPercent.assign(games, 0);
+    ratsEatenByCats.assign(games, 0);
+    buildingCount.assign(buildingBaseCost.size(), std::vector<int>(games, 0));
+    buildingMultiplier.assign(buildingBaseCost.size(), std::vector<float>(games, 1.0f));
+    refreshCats(0, games);
+}
+
+void BatchEnv::load(size_t game, const Simulation& sim) {
+    totalPies[game] = sim.game.totalPies.toInt();
+    piesBakedThisRun[game] = sim.game.piesBakedThisRun.toInt();
+    pieCarry[game] = sim.game.pieCarry;
+    totalRats[game] = sim.game.ratSystem.getTotalRats();
+    ratsEating[game] = sim.game.ratSystem.getRatsEating().toInt();
+    eatenCarry[game] = sim.game.ratSystem.getEatenCarry();
+    milkPurchased[game] = sim.catSystem.milkPurchased;
+    catnipLevel[game] = sim.catSystem.catnipLevel;
+    boostPercent[game] = sim.prestigeShop.boostPercent;
+
+    int building = 0;
+    for (const auto& item : sim.shopItems) {
+        if (const Building* b = dynamic_cast<const Building*>(item.get())) {
+            if (building >= buildingTypes()) break;
+            buildingCount[building][game] = b->getCount();
+            buildingMultiplier[building][game] = b->getMultiplier();
+            building++;
+        }
+    }
+    refreshPiesPerSecond(game, game + 1);
+    refreshCats(game, game + 1);
+}
+
+void BatchEnv::store(size_t game, Simulation& sim) const {
+    sim.game.totalPies = totalPies[game];
+    sim.game.piesPerSecond = piesPerSecond[game];
+    sim.game.piesBakedThisRun = piesBakedThisRun[game];
+    sim.game.pieCarry = pieCarry[game];
+    sim.game.untickedSeconds = untickedSeconds;
+    sim.catSystem.milkPurchased = milkPurchased[game];
+    sim.catSystem.catnipLevel = catnipLevel[game];
+    sim.prestigeShop.boostPercent = boostPercent[game];
+    sim.buildings.setBoostPercent(boostPercent[game]);
+
+    int building = 0;
+    for (const auto& item : sim.shopItems) {
+        if (const Building* b = dynamic_cast<const Building*>(item.get())) {
+            if (building >= buildingTypes()) break;
+            sim.buildings.setRow(b->getRow(), buildingCount[building][game], buildingMultiplier[building][game]);
+            building++;
+        }
+    }
+    // The batch keeps no per-rat rate; it only shows on screen
+    double single = rules.singleRatCurve(totalPies[game], piesPerSecond[game]);
+    sim.game.ratSystem.setState(totalRats[game], ratsEating[game], totalRats[game] > 0 ? (float)single : 0.0f,
+                                  eatenCarry[game]);
+}
+
+int BatchEnv::buildingCost(size_t game, int building) const {
+    int base = buildingBaseCost[building];
+    return base + buildingCount[building][game] * base / 2;
+}
+
+bool BatchEnv::buyBuilding(size_t game, int building) {
+    if (building < 0 || building >= buildingTypes()) return false;
+    int cost = buildingCost(game, building);
+    if (totalPies[game] < cost) return false;
+    totalPies[game] -= cost;
+    buildingCount[building][game]++;
+    refreshPiesPerSecond(game, game + 1);
+    return true;
+}
+
+int BatchEnv::buyBuildings(size_t game, int building, int count) {
+    if (building < 0 || building >= buildingTypes()) return 0;
+    int base = buildingBaseCost[building];
+    int owned = buildingCount[building][game];
+    if (count == BUY_MAX) count = (int)affordableBuildings(base, owned, totalPies[game]);
+    if (count <= 0 || count > INT_MAX - owned) return 0;
+    long long cost = bulkBuildingCost(base, owned, count).toInt64();
+    if (totalPies[game] < cost) return 0;
+    totalPies[game] -= (int)cost;
+    buildingCount[building][game] += count;
+    refreshPiesPerSecond(game, game + 1);
+    return count;
+}
+
+void BatchEnv::multiplyBuilding(size_t game, int building, float multiplier) {
+    if (building < 0 || building >= buildingTypes()) return;
+    buildingMultiplier[building][game] *= multiplier;
+    refreshPiesPerSecond(game, game + 1);
+}
+
+void BatchEnv::setPrestige(size_t game, int boost, int milk, int catnip) {
+    boostPercent[game] = boost;
+    milkPurchased[game] = milk;
+    catnipLevel[game] = catnip;
+    refreshPiesPerSecond(game, game + 1);
+    refreshCats(game, game + 1);
+}
+
+// ========================
+// KERNELS
+// ========================
+// Building::getPiesPerSecond summed over the catalog, same float rounding
+void BatchEnv::refreshPiesPerSecond(size_t begin, size_t end) {
+    int* pps = piesPerSecond.data();
+    const int* boost = boostPercent.data();
+    for (size_t g = begin; g < end; ++g) pps[g] = 0;
+    for (int b = 0; b < buildingTypes(); ++b) {
+        const int basePps = buildingBasePps[b];
+        const int* count = buildingCount[b].data();
+        const float* mult = buildingMultiplier[b].data();
+        for (size_t g = begin; g < end; ++g) {
+            pps[g] += int(basePps * count[g] * mult[g] * (100 + boost[g]) / 100.0f);
+        }
+    }
+}
+
+// CatSystem::getTotalCats() * CatSystem::ratsEatenPerCat()
+void BatchEnv::refreshCats(size_t begin, size_t end) {
+    const double LOG2_1_5 = 0.5849625007211562;
+    const int* milk = milkPurchased.data();
+    const int* catnip = catnipLevel.data();
+    int* eaten = ratsEatenByCats.data();
+    for (size_t g = begin; g < end; ++g) {
+        int cats = milk[g] + milk[g] / 9;
+        int perCat = 3 + int(3 * vecExp2(catnip[g] * LOG2_1_5) / 100.0f);
+        eaten[g] = cats * perCat;
+    }
+}
+
+void BatchEnv::step(float deltaTime) {
+    untickedSeconds += deltaTime;
+    for (int ticks = 0; ticks < MAX_TICKS_PER_STEP && untickedSeconds >= TICK_SECONDS - TICK_SLACK; ++ticks) {
+        untickedSeconds -= TICK_SECONDS;
+        tickKernel(gameCount, rules,
+                   totalPies.data(), piesBakedThisRun.data(), pieCarry.data(),
+                   totalRats.data(), ratsEating.data(), eatenCarry.data(),
+                   piesPerSecond.data(), ratsEatenByCats.data());
+    }
+}
+
+} // End of namespace piegame
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "Simulation.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace piegame {
+
+// ========================
+// BATCHED ENVIRONMENT
+// ========================
+// N independent games of the main economy kept as a structure of arrays:
+// one array per field, one slot per game. step() moves all of them through
+// the economy ticks of a frame with branch-free loops over those arrays
+// (production, rats, cats), which the compiler turns into SIMD code. There
+// are no ShopItem objects, virtual calls or dynamic_casts here: buildings
+// are plain counts and multipliers.
+//
+// Only the idle economy is batched (pies, buildings, rats, cats, Boost%).
+// The intro, messages and shop visibility stay with Simulation; use
+// load() to start a slot from any Simulation. The slots share one tick
+// clock, so load() takes a game's carries but not its time since the last
+// tick.
+//
+// Slots keep 32-bit ints, half the width of BigNumber's fast tier, so twice
+// as many games fit in a SIMD register. That covers runs to the 1,000,000
+// pie goal with a wide margin; load() clamps anything past INT_MAX.
+//
+// Build with -O3 (and -march=native if the batch stays on this machine) so
+// the kernels in BatchEnv.cpp are vectorized.
+class BatchEnv {
+public:
+    // Per-game state, indexed by game
+    std::vector<int> totalPies;
+    std::vector<int> piesPerSecond;
+    std::vector<int> piesBakedThisRun;
+    std::vector<int> pieCarry;         // In 1/TICKS_PER_SECOND pies, as in GameState
+    std::vector<int> totalRats;        // Rats left after the cats have eaten
+    std::vector<int> ratsEating;       // Pies the rats eat per second
+    std::vector<int> eatenCarry;       // In 1/TICKS_PER_SECOND pies, as in RatSystem
+    std::vector<int> milkPurchased;
+    std::vector<int> catnipLevel;
+    std::vector<int> boostPercent;
+    std::vector<int> ratsEatenByCats;  // totalCats * ratsEatenPerCat, kept up to date
+
+    // Per-building state, indexed [building][game]
+    std::vector<std::vector<int>> buildingCount;
+    std::vector<std::vector<float>> buildingMultiplier;
+
+    double untickedSeconds = 0.0; // Time stepped since the last tick, for every slot
+
+    // The building catalog is taken from a fresh game's shopItems
+    explicit BatchEnv(size_t games);
+
+    size_t size() const { return gameCount; }
+    int buildingTypes() const { return (int)buildingBaseCost.size(); }
+
+    // Copies the economy of a (main game) Simulation into slot `game`
+    void load(size_t game, const Simulation& sim);
+
+    // The reverse: writes slot `game`'s economy into a main-game Simulation
+    // (for checkpoints; see SaveFile.h). Upgrades' bought flags stay as they
+    // are in sim, the building multipliers carry their effect.
+    void store(size_t game, Simulation& sim) const;
+
+    // Cost of the next building of type `building` in slot `game`
+    int buildingCost(size_t game, int building) const;
+
+    // Buys one building if affordable; pies per second is updated at once
+    bool buyBuilding(size_t game, int building);
+
+    // Buys `count` buildings (all or none), or with BUY_MAX as many as the
+    // pies pay for, at the closed-form bulk price. Returns how many it bought.
+    int buyBuildings(size_t game, int building, int count);
+
+    // Multiplies a building's output (what Upgrade::purchase does)
+    void multiplyBuilding(size_t game, int building, float multiplier);
+
+    // Prestige shop levels for slot `game` (Boost%, Milk, Catnip)
+    void setPrestige(size_t game, int boost, int milk, int catnip);
+
+    // Advances every game by deltaTime seconds, in whole ticks as
+    // Simulation::step() does
+    void step(float deltaTime);
+
+private:
+    size_t gameCount;
+    std::vector<int> buildingBaseCost;
+    std::vector<int> buildingBasePps;
+    RatSystem rules; // Source of the rat constants
+
+    void refreshPiesPerSecond(size_t begin, size_t end);
+    void refreshCats(size_t begin, size_t end);
+};
+
+} // End of namespace piegame
@@ -0,0 +1,93 @@
+#include "BigNumber.h"
+
+#include <cstring>
+#include <ostream>
+#include <string_view>
+
+namespace piegame {
+
+namespace {
+
+// Suffixes for 10^0, 10^3, ... 10^33; past that, scientific notation
+const char* const SUFFIXES[] = { "", "K", "M", "B", "T", "Qa", "Qi", "Sx", "Sp", "Oc", "No", "Dc" };
+const int SUFFIX_GROUPS = sizeof(SUFFIXES) / sizeof(SUFFIXES[0]);
+
+// Writes the decimal digits of v, optionally grouped by commas. Digits are
+// produced from the right, into the end of a scratch buffer.
+int writeDigits(char* out, unsigned long long v, bool commas) {
+    char scratch[NUMBER_TEXT_MAX];
+    char* end = scratch + NUMBER_TEXT_MAX;
+    char* p = end;
+    int inGroup = 0;
+    do {
+        if (inGroup == 3) {
+            if (commas) *--p = ',';
+            inGroup = 0;
+        }
+        *--p = char('0' + v % 10);
+        v /= 10;
+        inGroup++;
+    } while (v > 0);
+    std::memcpy(out, p, end - p);
+    return (int)(end - p);
+}
+
+// 1.23M style: three significant digits, cut (not rounded) so the shown
+// value never runs ahead of the real one
+int writeShort(char* out, const BigNumber& value) {
+    int e = value.digitsExponent();
+    long long small = value.toInt64();
+    unsigned long long magnitude = small < 0 ? 0ULL - (unsigned long long)small : (unsigned long long)small;
+    if (!value.isWide() && e < 3) return writeDigits(out, magnitude, false);
+
+    int sig;
+    if (value.isWide()) {
+        sig = (int)(std::fabs(value.leadingDigits()) * 100.0);
+        sig = sig < 100 ? 100 : sig > 999 ? 999 : sig; // Rounding noise at the ends of [1, 10)
+    } else {
+        unsigned long long scale = 1;
+        for (int i = 2; i < e; ++i) scale *= 10;
+        sig = (int)(magnitude / scale);
+    }
+
+    int group = e / 3;
+    int intDigits = group < SUFFIX_GROUPS ? e % 3 + 1 : 1;
+    char digits[3] = { char('0' + sig / 100), char('0' + sig / 10 % 10), char('0' + sig % 10) };
+    int n = 0;
+    for (int i = 0; i < 3; ++i) {
+        if (i == intDigits) out[n++] = '.';
+        out[n++] = digits[i];
+    }
+    if (group < SUFFIX_GROUPS) {
+        for (const char* s = SUFFIXES[group]; *s; ++s) out[n++] = *s;
+    } else {
+        out[n++] = 'e';
+        n += writeDigits(out + n, (unsigned long long)e, false);
+    }
+    return n;
+}
+
+} // namespace
+
+int formatNumber(char* out, const BigNumber& value, NumberStyle style) {
+    int n = 0;
+    if (value < 0) out[n++] = '-';
+    if (style != NumberStyle::Short && !value.isWide()) {
+        long long v = value.toInt64();
+        unsigned long long magnitude = v < 0 ? 0ULL - (unsigned long long)v : (unsigned long long)v;
+        return n + writeDigits(out + n, magnitude, style == NumberStyle::Commas);
+    }
+    return n + writeShort(out + n, value);
+}
+
+void appendNumber(std::string& text, const BigNumber& value, NumberStyle style) {
+    char buffer[NUMBER_TEXT_MAX];
+    text.append(buffer, formatNumber(buffer, value, style));
+}
+
+std::ostream& operator<<(std::ostream& os, const BigNumber& value) {
+    char buffer[NUMBER_TEXT_MAX];
+    return os << std::string_view(buffer, formatNumber(buffer, value, NumberStyle::Plain)); // Keeps setw()
+}
+
+} // End of namespace piegame
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <cmath>
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <iosfwd>
+#include <string>
+
+namespace piegame {
+
+// ========================
+// BIG NUMBER
+// ========================
+// A pie, rat or star count that cannot overflow. Values below 10^18 are a
+// plain 64-bit integer and cost about as much as an int. Anything larger
+// is kept as mantissa * 10^exponent, with 1 <= |mantissa| < 10, which is
+// far enough for any idle game. Arithmetic moves between the two tiers on
+// its own; the wide tier keeps about 15 significant digits.
+class BigNumber {
+public:
+    constexpr BigNumber() : whole(0), exponent(0) {}
+    constexpr BigNumber(int value) : whole(value), exponent(0) {}
+    BigNumber(long long value) : whole(value), exponent(0) {
+        if (value >= SMALL_LIMIT || value <= -SMALL_LIMIT) *this = normalized((double)value, 0);
+    }
+
+    // Drops the fraction (towards zero), like an int cast
+    static BigNumber fromDouble(double value) {
+        if (value < (double)SMALL_LIMIT && value > -(double)SMALL_LIMIT) return BigNumber((long long)value);
+        if (std::isnan(value)) return BigNumber();
+        if (std::isinf(value)) value = value > 0 ? HUGE_FINITE : -HUGE_FINITE;
+        return normalized(value, 0);
+    }
+
+    bool isWide() const { return exponent != 0; }
+
+    // The stored fields, for fixed-layout files: the integer (small tier) or
+    // the mantissa's bit pattern (wide tier), and the exponent (0 if small)
+    long long rawBits() const {
+        long long bits;
+        std::memcpy(&bits, &whole, sizeof(bits)); // Either union member, as bytes
+        return bits;
+    }
+    int rawExponent() const { return exponent; }
+    static BigNumber fromRaw(long long bits, int exponent) {
+        BigNumber r;
+        std::memcpy(&r.whole, &bits, sizeof(bits));
+        r.exponent = exponent;
+        return r;
+    }
+
+    // Nearest double (infinite past 1.8e308)
+    double toDouble() const { return isWide() ? mantissa * std::pow(10.0, exponent) : (double)whole; }
+    explicit operator double() const { return toDouble(); }
+
+    // Clamped to the long long / int range
+    long long toInt64() const { return isWide() ? (mantissa > 0 ? LLONG_MAX : LLONG_MIN) : whole; }
+    int toInt() const {
+        long long v = toInt64();
+        return v > INT_MAX ? INT_MAX : v < INT_MIN ? INT_MIN : (int)v;
+    }
+
+    // Decimal exponent of the leading digit (0 for values below 10, including 0)
+    int digitsExponent() const {
+        if (isWide()) return exponent;
+        unsigned long long v = whole < 0 ? 0ULL - (unsigned long long)whole : (unsigned long long)whole;
+        int e = 0;
+        while (e < 18 && v >= POW10[e + 1]) e++;
+        return e;
+    }
+    // Leading digits as a value in [1, 10) (0 for zero); with digitsExponent()
+    // this is the number in scientific notation
+    double leadingDigits() const {
+        return isWide() ? mantissa : (double)whole / POW10[digitsExponent()];
+    }
+
+    BigNumber& operator+=(const BigNumber& other) {
+        if (!isWide() && !other.isWide()) {
+            whole += other.whole; // Both below 10^18, so no overflow
+            if (whole >= SMALL_LIMIT || whole <= -SMALL_LIMIT) *this = normalized((double)whole, 0);
+            return *this;
+        }
+        return *this = addWide(*this, other);
+    }
+    BigNumber& operator-=(const BigNumber& other) { return *this += -other; }
+    BigNumber& operator*=(const BigNumber& other) {
+        if (!isWide() && !other.isWide() && fitsProduct(whole) && fitsProduct(other.whole)) {
+            whole *= other.whole; // Both below 2^31, so below 2^62
+            if (whole >= SMALL_LIMIT || whole <= -SMALL_LIMIT) *this = normalized((double)whole, 0);
+            return *this;
+        }
+        double m = leadingDigits() * other.leadingDigits();
+        if (m == 0.0) return *this = BigNumber();
+        return *this = normalized(m, digitsExponent() + other.digitsExponent());
+    }
+    BigNumber& operator++() { return *this += 1; }
+    BigNumber operator++(int) { BigNumber old = *this; *this += 1; return old; }
+
+    BigNumber operator-() const {
+        BigNumber r = *this;
+        if (isWide()) r.mantissa = -mantissa;
+        else r.whole = -whole;
+        return r;
+    }
+
+    friend BigNumber operator+(BigNumber a, const BigNumber& b) { return a += b; }
+    friend BigNumber operator-(BigNumber a, const BigNumber& b) { return a -= b; }
+    friend BigNumber operator*(BigNumber a, const BigNumber& b) { return a *= b; }
+
+    friend bool operator==(const BigNumber& a, const BigNumber& b) {
+        if (a.exponent != b.exponent) return false;
+        return a.isWide() ? a.mantissa == b.mantissa : a.whole == b.whole;
+    }
+    friend bool operator!=(const BigNumber& a, const BigNumber& b) { return !(a == b); }
+    friend bool operator<(const BigNumber& a, const BigNumber& b) {
+        if (!a.isWide() && !b.isWide()) return a.whole < b.whole;
+        return compareWide(a, b) < 0;
+    }
+    friend bool operator>(const BigNumber& a, const BigNumber& b) { return b < a; }
+    friend bool operator<=(const BigNumber& a, const BigNumber& b) { return !(b < a); }
+    friend bool operator>=(const BigNumber& a, const BigNumber& b) { return !(a < b); }
+
+private:
+    static constexpr long long SMALL_LIMIT = 1000000000000000000LL; // 10^18
+    static constexpr double HUGE_FINITE = 1.7976931348623157e308;  // Where infinities are clamped to
+    static constexpr unsigned long long POW10[19] = {
+        1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+        1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+        100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+        1000000000000000000ULL
+    };
+
+    union {
+        long long whole;  // Small tier: the value itself
+        double mantissa;  // Wide tier: signed, 1 <= |mantissa| < 10
+    };
+    int exponent;         // 0 for the small tier, otherwise >= 18
+
+    static bool fitsProduct(long long v) { return v < (1LL << 31) && v > -(1LL << 31); }
+
+    // m * 10^e as a BigNumber in whichever tier it belongs
+    static BigNumber normalized(double m, int e) {
+        if (m == 0.0) return BigNumber();
+        int shift = (int)std::floor(std::log10(std::fabs(m)));
+        m /= std::pow(10.0, shift);
+        e += shift;
+        if (std::fabs(m) >= 10.0) { m /= 10.0; e++; } // log10 rounding at exact powers
+        if (std::fabs(m) < 1.0) { m *= 10.0; e--; }
+        if (e < 18) return BigNumber(std::llround(m * std::pow(10.0, e)));
+        BigNumber r;
+        r.mantissa = m;
+        r.exponent = e;
+        return r;
+    }
+
+    static BigNumber addWide(const BigNumber& a, const BigNumber& b) {
+        if (a.leadingDigits() == 0.0) return b;
+        if (b.leadingDigits() == 0.0) return a;
+        int ea = a.digitsExponent();
+        int eb = b.digitsExponent();
+        if (ea - eb > 17) return a; // The smaller one is below the last digit kept
+        if (eb - ea > 17) return b;
+        int e = ea > eb ? ea : eb;
+        double m = a.leadingDigits() * std::pow(10.0, ea - e) + b.leadingDigits() * std::pow(10.0, eb - e);
+        return normalized(m, e);
+    }
+
+    // Sign of a - b when at least one is wide
+    static int compareWide(const BigNumber& a, const BigNumber& b) {
+        double ma = a.leadingDigits();
+        double mb = b.leadingDigits();
+        int sa = (ma > 0) - (ma < 0);
+        int sb = (mb > 0) - (mb < 0);
+        if (sa != sb) return sa < sb ? -1 : 1;
+        if (sa == 0) return 0;
+        int ea = a.digitsExponent();
+        int eb = b.digitsExponent();
+        if (ea != eb) return (ea < eb ? -1 : 1) * sa;
+        return ma < mb ? -1 : ma > mb ? 1 : 0;
+    }
+};
+
+// ========================
+// NUMBER FORMATTING
+// ========================
+// These write into a caller's char buffer and never allocate; the result is
+// not 0-terminated. The buffer needs NUMBER_TEXT_MAX chars.
+const int NUMBER_TEXT_MAX = 32;
+
+enum class NumberStyle {
+    Commas, // 1,234,567 (Short from 10^18 on, where the wide tier starts)
+    Plain,  // 1234567 (also Short from 10^18 on), for logs and files
+    Short   // 1.23M, 45.6Qa, 7.89e45 (below 1,000 just the digits)
+};
+
+// Writes value in the given style and returns the number of chars written
+int formatNumber(char* out, const BigNumber& value, NumberStyle style = NumberStyle::Commas);
+
+// Appends the formatted value to text (no allocation once text has capacity)
+void appendNumber(std::string& text, const BigNumber& value, NumberStyle style = NumberStyle::Commas);
+
+// Prints in the Plain style
+std::ostream& operator<<(std::ostream& os, const BigNumber& value);
+
+} // End of namespace piegame
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+namespace piegame {
+
+// ========================
+// CURVE SWITCH
+// ========================
+// The rat and cat formulas call pow() on inputs that change slowly, so by
+// default they read lookup tables built on first use (see GameCore.cpp).
+// setExactCurves(true) puts every formula back on libm, to compare the two
+// or to rule the tables out. Set it before simulations start.
+inline std::atomic<bool> exactCurvesFlag{ false };
+
+inline void setExactCurves(bool exact) { exactCurvesFlag.store(exact, std::memory_order_relaxed); }
+inline bool exactCurves() { return exactCurvesFlag.load(std::memory_order_relaxed); }
+
+// ========================
+// STEP TABLE
+// ========================
+// A non-decreasing integer function of an integer x on [lo, hi], kept as the
+// first x at which each value is reached. Lookups give exactly what the
+// function gives wherever it really never decreases. An index over
+// 1024-wide buckets makes a lookup one load plus a short scan.
+class StepTable {
+public:
+    // Tabulates f(x) on [lo, hi]; costs about 20 calls of f per step in value
+    template <typename F>
+    void build(long long lo, long long hi, F f);
+
+    bool covers(long long x) const { return x >= lo && x <= hi; }
+
+    // f(x) for x in [lo, hi]
+    int at(long long x) const {
+        size_t bucket = (size_t)((x - lo) >> BUCKET_BITS);
+        int value = bucketValue[bucket];
+        size_t next = (size_t)(value - first);
+        while (next < starts.size() && starts[next] <= x) {
+            ++next;
+            ++value;
+        }
+        return value;
+    }
+
+private:
+    static const int BUCKET_BITS = 10;
+
+    long long lo = 0, hi = -1;
+    int first = 0;                 // f(lo)
+    std::vector<long long> starts; // starts[i]: first x where f(x) > first + i
+    std::vector<int> bucketValue;  // f at the start of each bucket
+};
+
+template <typename F>
+void StepTable::build(long long from, long long to, F f) {
+    lo = from;
+    hi = to;
+    first = f(lo);
+    int last = f(hi);
+    starts.clear();
+    long long below = lo; // f(below) < the value looked for
+    for (int value = first + 1; value <= last; ++value) {
+        long long top = hi; // f(top) >= value
+        while (top - below > 1) {
+            long long mid = below + (top - below) / 2;
+            if (f(mid) >= value) top = mid;
+            else below = mid;
+        }
+        starts.push_back(top);
+    }
+
+    bucketValue.clear();
+    size_t next = 0;
+    for (long long x = lo; x <= hi; x += 1LL << BUCKET_BITS) {
+        while (next < starts.size() && starts[next] <= x) ++next;
+        bucketValue.push_back(first + (int)next);
+    }
+}
+
+// ========================
+// CURVE TABLE
+// ========================
+// A smooth function on [lo, hi] as cubic Hermite pieces between evenly spaced
+// knots, from its values and slopes at the knots. build() checks the pieces
+// against the function at points between the knots and keeps the largest
+// relative error found as maxError().
+class CurveTable {
+public:
+    template <typename F, typename D>
+    void build(double lo, double hi, int pieces, F f, D slope);
+
+    bool covers(double x) const { return x >= lo && x <= hi; }
+
+    // The function at x in [lo, hi]
+    double at(double x) const {
+        double t = (x - lo) * perPiece;
+        int i = std::min((int)t, pieces - 1);
+        t -= i;
+        const double* c = &coefficients[4 * (size_t)i];
+        return ((c[3] * t + c[2]) * t + c[1]) * t + c[0];
+    }
+
+    double maxError() const { return largestError; }
+
+private:
+    static const int CHECKS_PER_PIECE = 7;
+
+    double lo = 0.0, hi = -1.0;
+    double perPiece = 0.0; // Pieces per unit of x
+    int pieces = 0;
+    std::vector<double> coefficients; // 4 per piece, constant term first, in t = 0..1
+    double largestError = 0.0;
+};
+
+template <typename F, typename D>
+void CurveTable::build(double from, double to, int count, F f, D slope) {
+    lo = from;
+    hi = to;
+    pieces = count;
+    double width = (hi - lo) / pieces;
+    perPiece = 1.0 / width;
+
+    coefficients.assign(4 * (size_t)pieces, 0.0);
+    double y0 = f(lo), d0 = slope(lo) * width;
+    for (int i = 0; i < pieces; ++i) {
+        double x1 = i + 1 == pieces ? hi : lo + (i + 1) * width;
+        double y1 = f(x1), d1 = slope(x1) * width;
+        double* c = &coefficients[4 * (size_t)i];
+        c[0] = y0;
+        c[1] = d0;
+        c[2] = 3.0 * (y1 - y0) - 2.0 * d0 - d1;
+        c[3] = 2.0 * (y0 - y1) + d0 + d1;
+        y0 = y1;
+        d0 = d1;
+    }
+
+    largestError = 0.0;
+    for (int i = 0; i < pieces; ++i) {
+        for (int k = 1; k <= CHECKS_PER_PIECE; ++k) {
+            double x = lo + (i + k / (CHECKS_PER_PIECE + 1.0)) * width;
+            double exact = f(x);
+            if (exact != 0.0) largestError = std::max(largestError, std::abs(at(x) / exact - 1.0));
+        }
+    }
+}
+
+} // End of namespace piegame
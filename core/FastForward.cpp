@@ -0,0 +1,257 @@
+#include "FastForward.h"
+
+#include <limits>
+
+namespace piegame {
+
+namespace {
+
+const double REL_TOLERANCE = 1e-7;  // Simpson panel tolerance (relative to panel time)...
+const double ABS_TOLERANCE = 1e-4;  // ...plus this many seconds, so steps in the rate stay cheap
+const double MIN_PANEL = 1e-3;      // Narrowest panel, in pies
+const double EQUILIBRIUM_GAP = 0.5; // Stop this many pies short of a rat equilibrium
+const double EXACT_BELOW = 64.0;    // Truncate exactly below this, on average above it
+
+// Small values are floored exactly, because the staircase decides where the
+// rats settle; large ones only lose half a unit on average and stay smooth so
+// the integrator does not have to resolve every step.
+double truncated(double value) {
+    return value < EXACT_BELOW ? std::floor(value) : value - 0.5;
+}
+
+// Net pies per second at a given pie count with no purchases
+struct PieFlow {
+    const RatSystem& rats;
+    const CatSystem& cats;
+    double piesPerSecond; // From buildings (the rats' appetite follows this)
+    double threshold;
+    double clicked = 0.0; // Pies per second from SPACE, on top
+
+    double rate(double pies) const {
+        if (pies < threshold) return piesPerSecond + clicked;
+        // tick() truncates the rat count and the pies/sec to int, then eats
+        // that rate exactly (the carry keeps the fractions)
+        double ratCount = truncated(rats.ratCurve(pies, cats));
+        if (ratCount <= 0.0) return piesPerSecond + clicked;
+        double eating = truncated(ratCount * rats.singleRatCurve(pies, piesPerSecond));
+        return piesPerSecond + clicked - eating;
+    }
+};
+
+// Pie count in [lo, hi] where the flow changes sign (the flow only falls as pies grow)
+double findEquilibrium(const PieFlow& flow, double lo, double hi) {
+    for (int i = 0; i < 100 && hi - lo > 1e-3; ++i) {
+        double mid = 0.5 * (lo + hi);
+        if (flow.rate(mid) > 0.0) lo = mid;
+        else hi = mid;
+    }
+    return 0.5 * (lo + hi);
+}
+
+// Simpson's rule for the time spent between a and b (integrand 1/rate)
+double simpson(double a, double b, double fa, double fm, double fb) {
+    return (b - a) / 6.0 * (fa + 4.0 * fm + fb);
+}
+
+// Integrates time = integral of dPies / rate from `from` towards `to`, where the
+// rate keeps the sign of (to - from). Stops when `budget` seconds are used up.
+// Returns the seconds used; `reached` is the pie count at that point.
+double march(const PieFlow& flow, double from, double to, double budget, double& reached) {
+    double x = from;
+    double used = 0.0;
+    double h = (to - from) / 16.0;
+    double fx = 1.0 / flow.rate(x);
+
+    while ((to - x) * h > 0.0) {
+        if ((x + h - to) * h > 0.0) h = to - x;
+
+        double fm = 1.0 / flow.rate(x + 0.5 * h);
+        double fb = 1.0 / flow.rate(x + h);
+        double whole = simpson(x, x + h, fx, fm, fb);
+        double fl = 1.0 / flow.rate(x + 0.25 * h);
+        double fr = 1.0 / flow.rate(x + 0.75 * h);
+        double halves = simpson(x, x + 0.5 * h, fx, fl, fm) + simpson(x + 0.5 * h, x + h, fm, fr, fb);
+        double error = std::abs(halves - whole);
+
+        if (error > REL_TOLERANCE * std::abs(halves) + ABS_TOLERANCE && std::abs(h) > MIN_PANEL) {
+            h *= 0.5;
+            continue;
+        }
+
+        if (used + halves >= budget) {
+            // Time runs out inside this panel: Newton on the panel's Simpson estimate
+            double remaining = budget - used;
+            double y = x + remaining / fx;
+            for (int i = 0; i < 8; ++i) {
+                if ((y - x) * h < 0.0) y = x;
+                if ((y - (x + h)) * h > 0.0) y = x + h;
+                double fy = 1.0 / flow.rate(y);
+                double part = simpson(x, y, fx, 1.0 / flow.rate(0.5 * (x + y)), fy);
+                double next = y + (remaining - part) / fy;
+                if (std::abs(next - y) < 1e-6) { y = next; break; }
+                y = next;
+            }
+            reached = y;
+            return budget;
+        }
+
+        used += halves;
+        x += h;
+        fx = fb;
+        if (error < 0.1 * REL_TOLERANCE * std::abs(halves)) h *= 2.0;
+    }
+    reached = to;
+    return used;
+}
+
+PieFlow makeFlow(const Simulation& sim) {
+    const RatSystem& rats = sim.game.ratSystem;
+    return { rats, sim.catSystem, sim.game.piesPerSecond.toDouble(), (double)rats.getThreshold() };
+}
+
+} // namespace
+
+double netPieRate(const Simulation& sim, const BigNumber& piesPerSecond) {
+    PieFlow flow = makeFlow(sim);
+    flow.piesPerSecond = piesPerSecond.toDouble();
+    return flow.rate(sim.game.totalPies.toDouble() + sim.game.pendingPies());
+}
+
+double timeUntilPies(const Simulation& sim, double targetPies) {
+    return timeBetweenPies(sim.game.ratSystem, sim.catSystem, sim.game.piesPerSecond.toDouble(), 0.0,
+                           sim.game.totalPies.toDouble() + sim.game.pendingPies(), targetPies);
+}
+
+double timeBetweenPies(const RatSystem& rats, const CatSystem& cats, double piesPerSecond, double clickedPerSecond,
+                       double fromPies, double toPies) {
+    const double NEVER = std::numeric_limits<double>::infinity();
+    PieFlow flow = { rats, cats, piesPerSecond, (double)rats.getThreshold(), clickedPerSecond };
+    double pies = fromPies;
+    double targetPies = toPies;
+    double linear = flow.piesPerSecond + flow.clicked;
+    if (pies >= targetPies) return 0.0;
+    if (linear <= 0) return NEVER;
+
+    // Straight line up to the rat threshold
+    double seconds = 0.0;
+    if (pies < flow.threshold) {
+        if (targetPies <= flow.threshold) return (targetPies - pies) / linear;
+        seconds = (flow.threshold - pies) / linear;
+        pies = flow.threshold;
+    }
+
+    // Rats in the way: reachable only if the flow is still positive at the target
+    if (flow.rate(targetPies) <= 0.0) return NEVER;
+    double reached = pies;
+    return seconds + march(flow, pies, targetPies, NEVER, reached);
+}
+
+FastForwardResult fastForward(Simulation& sim, double seconds, double stopAtPies) {
+    FastForwardResult result;
+    if (seconds <= 0.0) return result;
+    if (sim.intro.inIntro || sim.inPrestigeShop()) {
+        // Nothing is produced on these screens; only timers run
+        sim.step((float)seconds);
+        result.elapsed = seconds;
+        return result;
+    }
+
+    // The ticks step() would run in that time. The model covers all but the
+    // last, from the last tick on; the last one is run for real.
+    GameState& game = sim.game;
+    double ticks = std::floor((game.untickedSeconds + seconds) / TICK_SECONDS + TICK_SLACK / TICK_SECONDS);
+    if (ticks < 1.0) {
+        sim.step((float)seconds);
+        result.elapsed = seconds;
+        return result;
+    }
+    double budget = (ticks - 1.0) * TICK_SECONDS;
+
+    PieFlow flow = makeFlow(sim);
+    double pies = game.totalPies.toDouble() + game.pendingPies();
+    double elapsed = 0.0;
+
+    if (pies >= stopAtPies) {
+        result.reachedTarget = true; // Already there: nothing to run
+        return result;
+    }
+    if (pies < flow.threshold) {
+        // Closed-form segment: linear production up to the threshold or the target
+        if (flow.piesPerSecond > 0) {
+            double end = std::min(flow.threshold, stopAtPies);
+            double toEnd = (end - pies) / flow.piesPerSecond;
+            if (toEnd >= budget) {
+                pies += flow.piesPerSecond * budget;
+                elapsed = budget;
+            } else {
+                pies = end;
+                elapsed = toEnd;
+                result.reachedTarget = end >= stopAtPies;
+            }
+        } else {
+            elapsed = budget;
+        }
+    }
+
+    if (!result.reachedTarget && elapsed < budget) {
+        // Rat segment: integrate towards the target, the rat equilibrium, or the threshold
+        double rate = flow.rate(pies);
+        double left = budget - elapsed;
+        if (rate > 0.0) {
+            double end = stopAtPies;
+            bool isTarget = flow.rate(stopAtPies) > 0.0;
+            if (!isTarget) end = std::max(pies, findEquilibrium(flow, pies, stopAtPies) - EQUILIBRIUM_GAP);
+            double reached = pies;
+            elapsed += march(flow, pies, end, left, reached);
+            pies = reached;
+            if (elapsed < budget) {
+                if (isTarget) result.reachedTarget = true;
+                else elapsed = budget; // Settled at the equilibrium
+            }
+        } else if (rate < 0.0) {
+            // Rats eat faster than we bake: pies fall to the equilibrium or hover at the threshold
+            double end = flow.threshold;
+            if (flow.rate(flow.threshold) > 0.0) {
+                end = std::min(pies, findEquilibrium(flow, flow.threshold, pies) + EQUILIBRIUM_GAP);
+            }
+            double reached = pies;
+            march(flow, pies, end, left, reached);
+            pies = reached;
+            elapsed = budget;
+        } else {
+            elapsed = budget;
+        }
+    }
+
+    // Write back the modelled ticks (up to the one before reaching the
+    // target): production goes through pieCarry exactly as tick() does it
+    double modelled = ticks - 1.0;
+    if (result.reachedTarget) {
+        modelled = std::max(std::ceil(elapsed / TICK_SECONDS - TICK_SLACK / TICK_SECONDS) - 1.0, 0.0);
+        pies -= flow.rate(pies) * (elapsed - modelled * TICK_SECONDS);
+    }
+    double produced = game.pieCarry + flow.piesPerSecond * modelled; // In 1/TICKS_PER_SECOND pies
+    double wholePies = std::floor(produced / TICKS_PER_SECOND);
+    game.pieCarry = std::min(std::max((int)std::fmod(produced, TICKS_PER_SECOND), 0), TICKS_PER_SECOND - 1);
+    game.piesBakedThisRun += BigNumber::fromDouble(wholePies);
+    game.totalPies = BigNumber::fromDouble(std::max(std::floor(pies - game.pendingPies() + 0.5), 0.0));
+
+    // The last tick for real: prestige unlock/hint, rat counts and shop
+    // visibility. Message timers run for the whole time.
+    double before = game.untickedSeconds;
+    sim.messages.update((float)((modelled + 1.0) * TICK_SECONDS - before));
+    game.untickedSeconds = TICK_SECONDS;
+    sim.step(0.0f);
+    game.untickedSeconds = result.reachedTarget ? 0.0 : before + seconds - ticks * TICK_SECONDS;
+
+    result.elapsed = result.reachedTarget ? (modelled + 1.0) * TICK_SECONDS - before : seconds;
+    return result;
+}
+
+double catchUpOffline(Simulation& sim, int64_t savedAt, int64_t now) {
+    if (savedAt <= 0 || now <= savedAt || sim.intro.inIntro || sim.inPrestigeShop()) return 0.0;
+    double away = std::min((double)(now - savedAt), MAX_OFFLINE_SECONDS);
+    return fastForward(sim, away).elapsed;
+}
+
+} // End of namespace piegame
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Simulation.h"
+
+namespace piegame {
+
+// ========================
+// FAST FORWARD
+// ========================
+// Moves a game forward by long stretches of time without stepping frames.
+// With no purchases the economy is a one-dimensional flow
+//     dPies/dt = piesPerSecond - (pies eaten by rats per second)
+// so below the rat threshold it is a straight line (solved in closed form),
+// and above it the time to get from one pie count to another is the integral
+// of 1 / (dPies/dt), which is evaluated with adaptive Simpson panels.
+//
+// The rat term models what Simulation::step() does tick by tick, including
+// the average effect of its int truncations; the result is written back in
+// whole ticks, so it does not depend on a frame rate. Error bound against
+// frame-by-frame stepping (checked by bench/FastForwardBench.cpp): pie counts
+// agree to within 0.5% or 2 seconds of production, whichever is larger, and
+// "time until" answers to within 0.5% or 2 ticks.
+
+struct FastForwardResult {
+    double elapsed = 0.0;       // Seconds actually simulated
+    bool reachedTarget = false; // Stopped early because stopAtPies was reached
+};
+
+// Seconds until totalPies reaches targetPies with the current buildings and
+// no clicks or purchases. Returns infinity if rats hold the pie count below
+// the target (or nothing is being produced).
+double timeUntilPies(const Simulation& sim, double targetPies);
+
+// The same for any economy: seconds for the pie count to climb from fromPies
+// to toPies with buildings making piesPerSecond and the player clicking in
+// clickedPerSecond more. Lets planners ask about games they have not built.
+double timeBetweenPies(const RatSystem& rats, const CatSystem& cats, double piesPerSecond, double clickedPerSecond,
+                       double fromPies, double toPies);
+
+// Net pies per second right now if the buildings made piesPerSecond (the
+// model's dPies/dt). Above the rat threshold extra buildings also feed the
+// rats, so this can rise by much less than the buildings add, or even fall.
+double netPieRate(const Simulation& sim, const BigNumber& piesPerSecond);
+
+// Advances the game by `seconds` of idle time, stopping early when totalPies
+// reaches stopAtPies (the 1,000,000 pie goal unless told otherwise), at the
+// tick that gets there. Messages, the prestige unlock/hint and the rat
+// display are updated as if the frames had been played.
+FastForwardResult fastForward(Simulation& sim, double seconds, double stopAtPies = GOAL_PIES);
+
+// Offline progress: idles a game loaded from a save written at savedAt
+// (Unix seconds) through the time since, up to MAX_OFFLINE_SECONDS, as if
+// it had kept running. The intro and the prestige shop stand still, and a
+// clock that went backwards gives nothing. Returns the seconds covered.
+const double MAX_OFFLINE_SECONDS = 8 * 3600.0;
+double catchUpOffline(Simulation& sim, int64_t savedAt, int64_t now);
+
+} // End of namespace piegame
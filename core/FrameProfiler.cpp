@@ -0,0 +1,74 @@
+#include "FrameProfiler.h"
+
+#include <cstdio>
+
+namespace piegame {
+
+// ========================
+// LATENCY HISTOGRAM
+// ========================
+uint64_t LatencyHistogram::upperEdge(int bucket) {
+    if (bucket < 2 * (int)SUB) return (uint64_t)bucket;
+    int shift = bucket / (int)SUB - 1;
+    uint64_t sub = (uint64_t)(bucket % (int)SUB);
+    return ((SUB + sub + 1) << shift) - 1;
+}
+
+uint64_t LatencyHistogram::percentile(double p) const {
+    if (total == 0) return 0;
+    uint64_t rank = (uint64_t)(p * (double)(total - 1)) + 1;
+    uint64_t seen = 0;
+    for (int bucket = 0; bucket < BUCKETS; ++bucket) {
+        seen += counts[bucket];
+        if (seen >= rank) {
+            uint64_t edge = upperEdge(bucket);
+            return edge < largest ? edge : largest;
+        }
+    }
+    return largest;
+}
+
+void LatencyHistogram::reset() {
+    for (uint32_t& c : counts) c = 0;
+    total = 0;
+    largest = 0;
+}
+
+// ========================
+// FRAME PROFILER
+// ========================
+const char* phaseName(FramePhase phase) {
+    switch (phase) {
+    case FramePhase::Input: return "input";
+    case FramePhase::Purchase: return "purchase";
+    case FramePhase::Prestige: return "prestige";
+    case FramePhase::Messages: return "messages";
+    case FramePhase::Pies: return "pies";
+    case FramePhase::Rats: return "rats";
+    case FramePhase::Shop: return "shop";
+    case FramePhase::Render: return "render";
+    case FramePhase::Output: return "output";
+    case FramePhase::Save: return "save";
+    case FramePhase::Frame: return "frame";
+    default: return "?";
+    }
+}
+
+void FrameProfiler::reset() {
+    for (LatencyHistogram& h : phases) h.reset();
+}
+
+std::string FrameProfiler::summary() const {
+    std::string text = "phase           p50 us     p99 us     max us    samples\n";
+    char line[96];
+    for (int i = 0; i < (int)FramePhase::Count; ++i) {
+        const LatencyHistogram& h = phases[i];
+        if (h.count() == 0) continue;
+        snprintf(line, sizeof(line), "%-10s %11.1f %10.1f %10.1f %10llu\n", phaseName((FramePhase)i),
+                 h.percentile(0.5) / 1e3, h.percentile(0.99) / 1e3, h.max() / 1e3, (unsigned long long)h.count());
+        text += line;
+    }
+    return text;
+}
+
+} // End of namespace piegame
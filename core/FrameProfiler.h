@@ -0,0 +1,114 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace piegame {
+
+// ========================
+// LATENCY HISTOGRAM
+// ========================
+// HDR-style: durations in nanoseconds land in buckets that are exact below
+// 64 ns and 1/32 wide (about 3%) above, up to 2^40 ns (18 minutes; longer
+// ones count as that). record() finds the highest bit and bumps a counter;
+// percentiles are read by walking the ~1,100 buckets.
+class LatencyHistogram {
+public:
+    void record(uint64_t nanoseconds) {
+        counts[bucketOf(nanoseconds)]++;
+        total++;
+        if (nanoseconds > largest) largest = nanoseconds;
+    }
+
+    // Upper edge of the bucket holding the p-th fraction of samples (0..1)
+    uint64_t percentile(double p) const;
+    uint64_t max() const { return largest; }
+    uint64_t count() const { return total; }
+    void reset();
+
+private:
+    static const int SUB_BITS = 5;
+    static const uint64_t SUB = 1ull << SUB_BITS;
+    static const int MAX_BITS = 40;
+    static const int BUCKETS = (MAX_BITS - SUB_BITS + 1) * (int)SUB;
+
+    // Values below 2*SUB have a bucket each. Above, the highest bit picks a
+    // run of SUB buckets and the SUB_BITS bits after it the bucket in the run.
+    // Inline, so timing a Scope needs nothing from FrameProfiler.cpp.
+    static int bucketOf(uint64_t value) {
+        if (value < 2 * SUB) return (int)value;
+        int highest = 63;
+        while (!(value >> highest)) --highest;
+        if (highest >= MAX_BITS) return BUCKETS - 1;
+        int shift = highest - SUB_BITS;
+        return (shift + 1) * (int)SUB + (int)((value >> shift) - SUB);
+    }
+    static uint64_t upperEdge(int bucket);
+
+    uint32_t counts[BUCKETS] = {};
+    uint64_t total = 0;
+    uint64_t largest = 0;
+};
+
+// ========================
+// FRAME PROFILER
+// ========================
+// One histogram per phase of a frame. The front end and Simulation::step()
+// time their phases with Scope; a null profiler makes a Scope do nothing.
+enum class FramePhase {
+    Input,        // Draining the key queue (the actions below included)
+    Purchase,     // Buying a building or upgrade
+    Prestige,     // The prestige reset (the shop waits for keys: not timed)
+    Messages,     // messages.update
+    Pies,         // Pies per second added to the count
+    Rats,         // RatSystem::tick
+    Shop,         // Shop visibility
+    Render,       // Building the frame's text
+    Output,       // Sending the changed cells to the console
+    Save,         // Autosave
+    Frame,        // The whole frame, waiting not included
+    Count
+};
+
+const char* phaseName(FramePhase phase);
+
+class FrameProfiler {
+public:
+    static uint64_t now() {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void record(FramePhase phase, uint64_t nanoseconds) { phases[(int)phase].record(nanoseconds); }
+    const LatencyHistogram& histogram(FramePhase phase) const { return phases[(int)phase]; }
+    void reset();
+
+    // Frames recorded so far
+    uint64_t frames() const { return histogram(FramePhase::Frame).count(); }
+
+    // A table of p50 / p99 / max per phase, one line each, in microseconds
+    std::string summary() const;
+
+    // Times the enclosing block into one phase
+    class Scope {
+    public:
+        Scope(FrameProfiler* profiler, FramePhase phase)
+            : profiler(profiler), phase(phase), start(profiler ? now() : 0) {}
+        ~Scope() {
+            if (profiler) profiler->record(phase, now() - start);
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        FrameProfiler* profiler;
+        FramePhase phase;
+        uint64_t start;
+    };
+
+private:
+    LatencyHistogram phases[(int)FramePhase::Count];
+};
+
+} // End of namespace piegame
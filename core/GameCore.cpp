@@ -0,0 +1,277 @@
+#include "GameCore.h"
+#include "Curves.h"
+
+#include <climits>
+#include <ostream>
+
+namespace piegame {
+
+namespace {
+
+// ========================
+// CURVE TABLES
+// ========================
+// The pow() formulas below, tabulated on first use. Rat counts and cat
+// appetites are integers, so their tables are exact: StepTable finds the
+// pie count where each rat count starts with the formula itself, and the
+// catnip table is the formula at each level. The smooth rat curve the
+// fast-forward integrator reads is interpolated; its relative error is
+// below 1e-11 (bench/CurveBench checks all of these).
+const int RAT_CURVE_PIECES = 1024;
+const int CATNIP_LEVELS = 60;               // Higher levels overflow an int
+
+// Rats before the cats, as the rat update has always computed them
+int ratCountAt(double pies, const RatRules& rules) {
+    double progress = std::min(pies / RAT_PROGRESS_PIES, 1.0);
+    double exponent = rules.growth + rules.growthBoost * pow(progress, 2);
+    return static_cast<int>(std::min(3 * pow(pies / rules.threshold, exponent), (double)rules.maxRats));
+}
+
+// The same without truncation or cap, and its slope
+double ratCurveAt(double pies, const RatRules& rules) {
+    double progress = std::min(pies / RAT_PROGRESS_PIES, 1.0);
+    return 3 * pow(pies / rules.threshold, rules.growth + rules.growthBoost * pow(progress, 2));
+}
+
+double ratCurveSlope(double pies, const RatRules& rules) {
+    double progress = std::min(pies / RAT_PROGRESS_PIES, 1.0);
+    double exponent = rules.growth + rules.growthBoost * progress * progress;
+    double exponentSlope = pies <= RAT_PROGRESS_PIES ? 2.0 * rules.growthBoost * progress / RAT_PROGRESS_PIES : 0.0;
+    return ratCurveAt(pies, rules) * (exponentSlope * log(pies / rules.threshold) + exponent / pies);
+}
+
+int ratsPerCatAt(int catnipLevel) {
+    return 3 + int(3 * pow(1.5, catnipLevel) / 100.0f);
+}
+
+struct RatTables {
+    StepTable count; // ratCountAt over whole pies from the threshold to RAT_PROGRESS_PIES
+    CurveTable curve; // ratCurveAt over the same range
+};
+
+// Tables for the game's own RatRules, built on first use. Rats with other
+// rules (balance experiments) evaluate the formulas instead.
+const RatTables& ratTables() {
+    static const RatTables tables = [] {
+        RatTables t;
+        RatRules rules;
+        t.count.build(rules.threshold, (long long)RAT_PROGRESS_PIES,
+                      [&](long long pies) { return ratCountAt((double)pies, rules); });
+        t.curve.build(rules.threshold, RAT_PROGRESS_PIES, RAT_CURVE_PIECES,
+                      [&](double pies) { return ratCurveAt(pies, rules); },
+                      [&](double pies) { return ratCurveSlope(pies, rules); });
+        return t;
+    }();
+    return tables;
+}
+
+} // namespace
+
+// ========================
+// CAT SYSTEM
+// ========================
+int CatSystem::ratsEatenPerCat() const {
+    static const std::vector<int> table = [] {
+        std::vector<int> t;
+        for (int level = 0; level < CATNIP_LEVELS; ++level) t.push_back(ratsPerCatAt(level));
+        return t;
+    }();
+    if (exactCurves() || catnipLevel < 0 || catnipLevel >= CATNIP_LEVELS) return ratsPerCatAt(catnipLevel);
+    return table[catnipLevel];
+}
+
+// ========================
+// RAT SYSTEM
+// ========================
+BigNumber tickShare(const BigNumber& perSecond, int& carry) {
+    if (perSecond.isWide()) {
+        return BigNumber::fromDouble(perSecond.toDouble() / TICKS_PER_SECOND); // A fraction of a pie is noise here
+    }
+    long long units = perSecond.toInt64() + carry;
+    carry = (int)(units % TICKS_PER_SECOND);
+    return BigNumber(units / TICKS_PER_SECOND);
+}
+
+void RatSystem::tick(BigNumber& totalPies, const BigNumber& piesPerSecond, const CatSystem& catSystem) {
+    if (totalPies >= constants.threshold) {
+        // Calculate how many rats should appear based on total pies
+        double pies = totalPies.toDouble();
+        double progress = std::min(pies / RAT_PROGRESS_PIES, 1.0);
+        bool tabled = standardRules && !exactCurves() && !totalPies.isWide();
+        if (tabled && ratTables().count.covers(totalPies.toInt64())) {
+            totalRats = ratTables().count.at(totalPies.toInt64());
+        } else {
+            totalRats = ratCountAt(pies, constants);
+        }
+
+        // Cats eat rats before rats eat pies
+        int totalCats = catSystem.getTotalCats();
+        int ratsEatenPerCat = catSystem.ratsEatenPerCat();
+        int totalRatsEaten = totalCats * ratsEatenPerCat;
+        if (totalRatsEaten > totalRats) totalRatsEaten = totalRats;
+        totalRats -= totalRatsEaten;
+        if (totalRats < 0) totalRats = 0;
+
+        // Rats eat pies. The rate takes float math (the batch kernels repeat
+        // it exactly) until the numbers get wide, doubles after that.
+        double cubed = exactCurves() ? pow(progress, 3) : progress * progress * progress;
+        double singleRatEatRate = constants.eatRate + (0.005f + 0.025f * cubed) * piesPerSecond.toDouble();
+        if (!totalPies.isWide() && !piesPerSecond.isWide()) {
+            ratsEating = BigNumber::fromDouble(totalRats * (float)singleRatEatRate);
+        } else {
+            ratsEating = BigNumber::fromDouble(totalRats * singleRatEatRate);
+        }
+        BigNumber eaten = tickShare(ratsEating, eatenCarry);
+        if (eaten > totalPies) {
+            eaten = totalPies; // Nothing left to carry a bite of
+            eatenCarry = 0;
+        }
+        totalPies -= eaten;
+        ratsEatingSingle = (float)singleRatEatRate;
+    } else {
+        // No rats if under threshold
+        totalRats = 0;
+        ratsEating = 0;
+        ratsEatingSingle = 0;
+        eatenCarry = 0;
+    }
+}
+
+double RatSystem::ratCurve(double totalPies, const CatSystem& catSystem) const {
+    if (totalPies < constants.threshold) return 0.0;
+    bool tabled = standardRules && !exactCurves() && ratTables().curve.covers(totalPies);
+    double rats = tabled ? ratTables().curve.at(totalPies) : ratCurveAt(totalPies, constants);
+    rats = std::min(rats, (double)constants.maxRats);
+    rats -= catSystem.getTotalCats() * catSystem.ratsEatenPerCat();
+    return std::max(rats, 0.0);
+}
+
+double RatSystem::singleRatCurve(double totalPies, double piesPerSecond) const {
+    double progress = std::min(totalPies / RAT_PROGRESS_PIES, 1.0);
+    double cubed = exactCurves() ? pow(progress, 3) : progress * progress * progress;
+    return constants.eatRate + (0.005 + 0.025 * cubed) * piesPerSecond;
+}
+
+std::ostream& operator<<(std::ostream& os, const GameState& gs) {
+    os << "Pies: " << gs.totalPies
+       << "\nPrestige: " << gs.prestigeStars
+       << "\nRats: " << gs.ratSystem.getTotalRats();
+    return os;
+}
+
+// ========================
+// BULK PRICES
+// ========================
+BigNumber bulkBuildingCost(int baseCost, long long owned, long long n) {
+    if (n <= 0) return BigNumber();
+    // Sum of k over owned..owned+n-1, and how many of those k are odd
+    double steps = n * (double)owned + n * (n - 1) / 2.0;
+    long long odd = baseCost % 2 ? (owned + n) / 2 - owned / 2 : 0;
+    double estimate = n * (double)baseCost + baseCost * steps / 2.0;
+    if (estimate < 1e17) {
+        long long exactSteps = n * owned + n * (n - 1) / 2;
+        return BigNumber(n * baseCost + (baseCost * exactSteps - odd) / 2);
+    }
+    return BigNumber::fromDouble(estimate - odd / 2.0);
+}
+
+long long affordableBuildings(int baseCost, long long owned, const BigNumber& pies) {
+    long long limit = INT_MAX - owned;
+    double budget = pies.toDouble();
+    if (!(budget > 0.0) || limit <= 0) return 0;
+
+    // baseCost / 4 * n^2 + baseCost * (3 / 4 + owned / 2) * n = budget, less
+    // the rounding; this form of the root stays accurate when n is small
+    double a = baseCost / 4.0;
+    double b = baseCost * (0.75 + owned / 2.0);
+    double root = 2.0 * budget / (b + std::sqrt(b * b + 4.0 * a * budget));
+    long long n = root < (double)limit ? (long long)root : limit;
+
+    // Rounding moves the answer by a building or two at most
+    while (n < limit && bulkBuildingCost(baseCost, owned, n + 1) <= pies) n++;
+    while (n > 0 && bulkBuildingCost(baseCost, owned, n) > pies) n--;
+    return n;
+}
+
+// ========================
+// BUILDING TABLE
+// ========================
+void BuildingTable::reset(int boost) {
+    rows.clear();
+    boostPercent = boost;
+    totalPps = 0;
+    ownedRows = 0;
+}
+
+int BuildingTable::add(int baseCost, int basePps) {
+    Row r;
+    r.baseCost = baseCost;
+    r.basePps = basePps;
+    rows.push_back(r);
+    return (int)rows.size() - 1;
+}
+
+void BuildingTable::setBoostPercent(int boost) {
+    if (boost == boostPercent) return;
+    boostPercent = boost;
+    if (ownedRows == 0) return; // Nothing built yet: every output stays 0
+    for (int i = 0; i < size(); ++i) refreshRow(i);
+}
+
+// ========================
+// SHOP
+// ========================
+BigNumber calculatePiesPerSecond(const ShopList& shopItems) {
+    BigNumber total;
+    for (const auto& item : shopItems) {
+        if (auto* b = dynamic_cast<Building*>(item.get())) {
+            total += b->getPiesPerSecond();
+        }
+    }
+    return total;
+}
+
+void initializeShopItems(ShopList& shopItems, BuildingTable& buildings, const PrestigeShop& prestigeShop,
+                         const ShopCatalog& catalog) {
+    shopItems.clear();
+    shopItems.resize(catalog.size());
+    buildings.reset(prestigeShop.boostPercent);
+
+    // Buildings first (rows in catalog order), so every upgrade finds its
+    // building; prerequisites are always listed above the upgrade
+    for (int i = 0; i < catalog.size(); ++i) {
+        const CatalogEntry& e = catalog[i];
+        if (e.kind == ShopKind::Building) {
+            shopItems[i] = std::make_unique<Building>(e.name, buildings, buildings.add(e.cost, e.piesPerSecond));
+        }
+    }
+    for (int i = 0; i < catalog.size(); ++i) {
+        const CatalogEntry& e = catalog[i];
+        if (e.kind != ShopKind::Upgrade) continue;
+        Building* target = static_cast<Building*>(shopItems[e.target].get());
+        Upgrade* prerequisite = e.prerequisite >= 0 ? static_cast<Upgrade*>(shopItems[e.prerequisite].get()) : nullptr;
+        shopItems[i] = std::make_unique<Upgrade>(e.name, e.cost, e.multiplier, target, prerequisite);
+    }
+}
+
+// ========================
+// HELPER FUNCTIONS
+// ========================
+std::string formatWithCommas(const BigNumber& value) {
+    std::string num;
+    appendNumber(num, value);
+    return num;
+}
+
+std::string formatDuration(double seconds) {
+    long long total = (long long)std::ceil(seconds);
+    long long hours = total / 3600;
+    int minutes = (int)(total / 60 % 60);
+    int secs = (int)(total % 60);
+    auto twoDigits = [](int v) { return (v < 10 ? "0" : "") + std::to_string(v); };
+    if (hours > 0) return std::to_string(hours) + "h " + twoDigits(minutes) + "m " + twoDigits(secs) + "s";
+    if (minutes > 0) return std::to_string(minutes) + "m " + twoDigits(secs) + "s";
+    return std::to_string(secs) + "s";
+}
+
+} // End of namespace piegame
@@ -0,0 +1,409 @@
+#pragma once
+
+#include <cmath>         // For math functions like pow, sqrt
+#include <vector>        // For dynamic arrays (STL vector)
+#include <string>        // For string manipulation
+#include <iosfwd>        // For the GameState debug printer
+#include <memory>        // For smart pointers (unique_ptr)
+#include <algorithm>     // For std::min / std::max
+
+#include "BigNumber.h"   // Pie counts that do not overflow
+#include "ShopCatalog.h" // Buildings and upgrades as content
+
+// Platform-free game rules. Nothing in this header may include windows.h or
+// conio.h: the console front end (Piemaker.cpp), the simulation and the
+// benchmarks all share it.
+namespace piegame {
+
+// ========================
+// ECONOMY TICK
+// ========================
+// Production and rats move in fixed ticks, whatever the frame rate:
+// Simulation::step() runs as many whole ticks as its frames add up to.
+// Fractions of a pie carry over from tick to tick as a count of
+// 1/TICKS_PER_SECOND pies, so a pies-per-second rate adds up exactly, at
+// any frame rate and however short the frames.
+const int TICKS_PER_SECOND = 30;
+const double TICK_SECONDS = 1.0 / TICKS_PER_SECOND;
+const double TICK_SLACK = 1e-6; // Frames a float rounding short of a tick still make it
+const int MAX_TICKS_PER_STEP = TICKS_PER_SECOND * 600; // Longer gaps catch up over several steps
+
+// One tick of `perSecond`: whole pies out, the rest (in 1/TICKS_PER_SECOND
+// pies) left in `carry` for the next tick
+BigNumber tickShare(const BigNumber& perSecond, int& carry);
+
+// ========================
+// CAT SYSTEM
+// ========================
+// Handles all logic and state related to cats and catnip
+struct CatSystem {
+    int milkPurchased = 0;   // Number of milk upgrades (affects cats)
+    int catnipLevel = 0;     // Catnip level (affects cats' rat-eating power)
+
+    // Calculate total cats based on milk upgrades
+    int getTotalCats() const {
+        return milkPurchased + (milkPurchased / 9);
+    }
+
+    // Calculate how many rats a single cat can eat per second
+    // (3 + 3 * 1.5^catnip / 100, from a table; see Curves.h)
+    int ratsEatenPerCat() const;
+};
+
+// ========================
+// RAT SYSTEM
+// ========================
+// The rats' balance constants. Rats show up at `threshold` pies and number
+// 3 * (pies / threshold)^(growth + growthBoost * progress^2), where progress
+// runs from 0 to 1 over the first RAT_PROGRESS_PIES pies, up to maxRats.
+// The defaults are the game as shipped; balance tools try others.
+const int RAT_PROGRESS_PIES = 1000000; // Rats grow faster up to here, then the exponent stays put
+
+struct RatRules {
+    int threshold = 50000;     // Minimum pies before rats appear
+    float eatRate = 1.0f;      // Base rate at which rats eat pies
+    int maxRats = 999999;      // Maximum number of rats
+    double growth = 1.01;
+    double growthBoost = 0.7;
+
+    bool operator==(const RatRules& o) const {
+        return threshold == o.threshold && eatRate == o.eatRate && maxRats == o.maxRats && growth == o.growth &&
+               growthBoost == o.growthBoost;
+    }
+};
+
+// Handles the logic for rats that steal pies if you have too many pies
+class RatSystem {
+private:
+    int totalRats = 0;           // Number of rats currently present
+    BigNumber ratsEating;        // Pies the rats eat per second
+    int eatenCarry = 0;          // Pies half-eaten, in 1/TICKS_PER_SECOND pies
+    float ratsEatingSingle = 0.0f; // How many pies a single rat eats per second
+    bool ratsWereVisible = false; // Used to track if rats were visible last frame
+    RatRules constants;
+    bool standardRules = true;   // The curve tables (Curves.h) only hold the defaults
+
+public:
+    // Advances the rats by one economy tick
+    void tick(BigNumber& totalPies, const BigNumber& piesPerSecond, const CatSystem& catSystem);
+
+    // Smooth versions of the tick() formulas (no int truncation), used by
+    // the fast-forward integrator. Rats left after the cats have eaten:
+    double ratCurve(double totalPies, const CatSystem& catSystem) const;
+    // Pies per second a single rat eats at this pie count:
+    double singleRatCurve(double totalPies, double piesPerSecond) const;
+    int getThreshold() const { return constants.threshold; }
+    float getEatRate() const { return constants.eatRate; }
+    int getMaxRats() const { return constants.maxRats; }
+    const RatRules& rules() const { return constants; }
+    void setRules(const RatRules& rules) {
+        constants = rules;
+        standardRules = rules == RatRules();
+    }
+
+    // Getters for rat stats
+    int getTotalRats() const { return totalRats; }
+    const BigNumber& getRatsEating() const { return ratsEating; }
+    int getEatenCarry() const { return eatenCarry; }
+    float getRatsEatingSingle() const { return ratsEatingSingle; }
+    bool areRatsVisible() const { return totalRats > 0; }
+    bool wereRatsVisible() const { return ratsWereVisible; }
+    void setRatsWereVisible(bool v) { ratsWereVisible = v; }
+    // Puts back counts from the last tick() (restoring a save)
+    void setState(int rats, const BigNumber& eating, float eatingSingle, int carry) {
+        totalRats = rats;
+        ratsEating = eating;
+        ratsEatingSingle = eatingSingle;
+        eatenCarry = carry;
+    }
+};
+
+// ========================
+// GAME STATE VARIABLES
+// ========================
+// Holds all persistent game state for the current run
+struct GameState {
+    BigNumber totalPies;         // Total pies baked
+    BigNumber piesPerSecond;     // Current pies per second
+    float prestigeStars = 0;     // Prestige currency
+    int pieCarry = 0;            // Production short of a whole pie, in 1/TICKS_PER_SECOND pies
+    double untickedSeconds = 0.0; // Time stepped since the last economy tick
+    bool goalAchieved = false;   // Has the player reached the win condition?
+    bool prestigeUnlocked = false; // Has prestige been unlocked?
+    BigNumber piesBakedThisRun;  // Pies baked in this run (for prestige)
+    bool prestigeHintShown = false; // Has the prestige hint been shown?
+    RatSystem ratSystem;         // The rat system for this game
+
+    // The part of a pie that production has made so far
+    double pendingPies() const { return pieCarry / (double)TICKS_PER_SECOND; }
+};
+
+// Overload << to print GameState for debugging
+std::ostream& operator<<(std::ostream& os, const GameState& gs);
+
+const int GOAL_PIES = 1000000;       // Win condition
+const int PRESTIGE_MIN_PIES = 1000;  // Pies baked this run before prestige is allowed
+const int PRESTIGE_HINT_PIES = 500000; // Pies baked this run before the prestige tip
+
+// ========================
+// INTRO STATE
+// ========================
+// Tracks the state of the intro/tutorial sequence
+struct IntroState {
+    bool inIntro = true;             // Are we in the intro?
+    int spacePresses = 0;            // How many times space has been pressed
+    int announcementStep = 0;        // Which milestone announcement we're on
+    bool unlockAvailable = false;    // Can the player unlock buildings?
+    bool buildingsUnlocked = false;  // Has the player unlocked buildings?
+    bool clearedAfterFirstSpace = false; // Has the screen been cleared after first space?
+};
+
+const float INTRO_ANNOUNCEMENT_DURATION = 5.0f; // How long intro messages last
+const int UNLOCK_BUILDINGS_COST = 50;           // Price of the [U] unlock in the intro
+
+// ========================
+// PRESTIGE SHOP SYSTEM
+// ========================
+// Star prices of the cat upgrades (see PrestigeCatalog.h), for balance tools
+struct PrestigePrices {
+    int milkBase = 10;          // Milk costs milkBase + milkStep * milk owned
+    int milkStep = 2;
+    int catnipBase = 1;         // Catnip costs catnipBase + catnipStep * level
+    int catnipStep = 1;
+};
+
+// State bought in the prestige shop. The upgrades themselves are listed in
+// PrestigeCatalog.h.
+struct PrestigeShop {
+    int boostPercent = 0;       // % boost to all production
+    bool hasGoldenSword = false;// Cosmetic upgrade
+    bool inShop = false;        // Is the player in the shop?
+    PrestigePrices prices;
+};
+
+// ========================
+// BULK PRICES
+// ========================
+// The k-th building of a kind (k = 0 for the first) costs base + k * base / 2,
+// rounded down. Buying several sums that series in closed form: the prices
+// without rounding are an arithmetic series, and rounding takes half a pie
+// off each odd product k * base.
+BigNumber bulkBuildingCost(int baseCost, long long owned, long long n);
+
+// The most buildings `pies` pays for with `owned` already bought: the root
+// of the quadratic the series gives, then corrected to the exact prices
+long long affordableBuildings(int baseCost, long long owned, const BigNumber& pies);
+
+// ========================
+// BUILDING TABLE
+// ========================
+// All buildings of one game as a flat array of plain rows, apart from the
+// polymorphic shop list. Each row caches its own output, and the table keeps
+// their sum, so every change (a purchase, an upgrade's multiplier) adjusts
+// the total by one row's difference instead of walking the shop.
+class BuildingTable {
+public:
+    struct Row {
+        int baseCost;      // Price of the first one
+        int basePps;       // Pies per second of one, before multipliers
+        int count = 0;
+        float multiplier = 1.0f;
+        BigNumber output;  // Pies per second of all of them, Boost% included
+    };
+
+    // Empties the table for a new run
+    void reset(int boost);
+
+    // Adds a building type and returns its row index
+    int add(int baseCost, int basePps);
+
+    const Row& row(int i) const { return rows[i]; }
+    int size() const { return (int)rows.size(); }
+
+    BigNumber getCost(int i) const {
+        return BigNumber(rows[i].baseCost + (long long)rows[i].count * rows[i].baseCost / 2);
+    }
+    // Price of the next n of row i
+    BigNumber getCost(int i, int n) const { return bulkBuildingCost(rows[i].baseCost, rows[i].count, n); }
+    // How many more of row i `pies` pays for (never past INT_MAX in all)
+    int affordable(int i, const BigNumber& pies) const {
+        return (int)affordableBuildings(rows[i].baseCost, rows[i].count, pies);
+    }
+
+    // Output of row i if it had n buildings and multiplier m (in double:
+    // a buy-max can take the count past where basePps * n fits an int)
+    BigNumber outputFor(int i, int n, float m) const {
+        return BigNumber::fromDouble((double)rows[i].basePps * n * m * (100 + boostPercent) / 100.0);
+    }
+
+    void addCount(int i, int n) {
+        ownedRows -= rows[i].count > 0;
+        rows[i].count += n;
+        ownedRows += rows[i].count > 0;
+        refreshRow(i);
+    }
+    void multiply(int i, float m) {
+        rows[i].multiplier *= m;
+        refreshRow(i);
+    }
+    // Sets a row outright (restoring a save)
+    void setRow(int i, int count, float m) {
+        ownedRows -= rows[i].count > 0;
+        rows[i].count = count;
+        rows[i].multiplier = m;
+        ownedRows += count > 0;
+        refreshRow(i);
+    }
+
+    // Boost% only changes in the prestige shop, right after a reset, when
+    // every count is 0 and the total stays 0. Tools that change it mid-run
+    // pay one pass over the table.
+    void setBoostPercent(int boost);
+
+    // Pies per second of all buildings, kept up to date on every change
+    const BigNumber& getTotalPiesPerSecond() const { return totalPps; }
+
+private:
+    std::vector<Row> rows;
+    int boostPercent = 0;
+    BigNumber totalPps;
+    int ownedRows = 0; // Rows with count > 0
+
+    void refreshRow(int i) {
+        Row& r = rows[i];
+        BigNumber output = r.count > 0 ? outputFor(i, r.count, r.multiplier) : BigNumber();
+        totalPps += output - r.output;
+        r.output = output;
+    }
+};
+
+// ========================
+// GAME CLASSES
+// ========================
+
+// Abstract base class for all shop items (buildings and upgrades)
+class ShopItem {
+protected:
+    bool wasVisible = false; // Tracks if the item has ever been visible
+public:
+    virtual ~ShopItem() = default;
+    virtual std::string getName() const = 0;
+    virtual BigNumber getCost() const = 0;
+    virtual bool canPurchase(const BigNumber& pies) const = 0;
+    virtual void purchase() = 0;
+    virtual std::string getDescription() const = 0;
+    virtual bool isVisible(const BigNumber& pies) const { return true; }
+    virtual BigNumber getPiesPerSecond() const { return 0; }
+    // How much the game's pies per second would rise if this were bought now
+    virtual BigNumber getPiesPerSecondGain() const { return 0; }
+
+    // Tracks if the item has ever been visible (for display logic)
+    bool hasBeenVisible() const { return wasVisible; }
+    void setWasVisible() { wasVisible = true; }
+};
+
+// Represents a building that produces pies per second. The numbers live in
+// a BuildingTable row; this is the shop's view of it.
+class Building : public ShopItem {
+protected:
+    std::string name;
+    BuildingTable* table;
+    int index;          // Row in the table
+    bool visible;
+public:
+    Building(const std::string& n, BuildingTable& t, int row, bool vis = false)
+        : name(n), table(&t), index(row), visible(vis) {}
+
+    std::string getName() const override { return name; }
+    BigNumber getCost() const override { return table->getCost(index); }
+    bool canPurchase(const BigNumber& pies) const override { return pies >= getCost(); }
+    void purchase() override { table->addCount(index, 1); }
+    // n at once: one price, one pies per second update
+    BigNumber getCost(int n) const { return table->getCost(index, n); }
+    int getAffordable(const BigNumber& pies) const { return table->affordable(index, pies); }
+    void purchase(int n) { table->addCount(index, n); }
+    std::string getDescription() const override {
+        std::string text = name + " (Count: " + std::to_string(getCount()) + ", +";
+        appendNumber(text, getPiesPerSecond());
+        return text + " pies/sec)";
+    }
+    int getRow() const { return index; }
+    int getCount() const { return table->row(index).count; }
+    int getBaseCost() const { return table->row(index).baseCost; }
+    int getBasePiesPerSecond() const { return table->row(index).basePps; }
+    float getMultiplier() const { return table->row(index).multiplier; }
+    // Output with n of these buildings and multiplier m (Boost% included)
+    BigNumber getPiesPerSecondFor(int n, float m) const { return table->outputFor(index, n, m); }
+    BigNumber getPiesPerSecond() const override { return table->row(index).output; }
+    BigNumber getPiesPerSecondGain() const override {
+        return getPiesPerSecondFor(getCount() + 1, getMultiplier()) - getPiesPerSecond();
+    }
+    void multiplyMultiplier(float m) { table->multiply(index, m); }
+    bool isVisible(const BigNumber& pies) const override { return visible || pies >= getBaseCost(); }
+    void setVisible(bool v) { visible = v; }
+};
+
+// Represents an upgrade that boosts a building's output
+class Upgrade : public ShopItem {
+    std::string name;
+    int cost;
+    float multiplier;
+    Building* target;
+    bool purchased = false;
+    Upgrade* prerequisite = nullptr;
+public:
+    Upgrade(const std::string& n, int c, float m, Building* t, Upgrade* prereq = nullptr)
+        : name(n), cost(c), multiplier(m), target(t), prerequisite(prereq) {}
+
+    std::string getName() const override { return name; }
+    BigNumber getCost() const override { return cost; }
+    bool canPurchase(const BigNumber& pies) const override { return !purchased && pies >= cost; }
+    void purchase() override {
+        if (!purchased && target) {
+            target->multiplyMultiplier(multiplier); // Multiply output
+            purchased = true;
+        }
+    }
+    std::string getDescription() const override {
+        return "Boosts " + target->getName() + " output by x" + std::to_string((int)multiplier);
+    }
+    bool isVisible(const BigNumber& pies) const override {
+        // Only visible if not purchased, you have enough pies, and prerequisite (if any) is purchased
+        bool prereqOk = !prerequisite || prerequisite->isPurchased();
+        return !purchased && prereqOk && pies >= cost / 2;
+    }
+    bool isPurchased() const { return purchased; }
+    float getMultiplier() const { return multiplier; }
+    const Building* getTarget() const { return target; }
+    const Upgrade* getPrerequisite() const { return prerequisite; }
+    // Marks as bought without applying the multiplier again (restoring a save)
+    void setPurchased(bool p) { purchased = p; }
+    BigNumber getPiesPerSecondGain() const override {
+        if (purchased || !target) return 0;
+        return target->getPiesPerSecondFor(target->getCount(), target->getMultiplier() * multiplier) -
+               target->getPiesPerSecond();
+    }
+};
+
+// All shop items (buildings and upgrades) of one game
+typedef std::vector<std::unique_ptr<ShopItem>> ShopList;
+
+// Calculates the total pies per second by walking every building in the shop
+// (the game itself reads BuildingTable::getTotalPiesPerSecond)
+BigNumber calculatePiesPerSecond(const ShopList& shopItems);
+
+// Initializes all shop items (buildings and upgrades) from the catalog, in
+// its order; the buildings' rows go into `buildings`
+void initializeShopItems(ShopList& shopItems, BuildingTable& buildings, const PrestigeShop& prestigeShop,
+                         const ShopCatalog& catalog = ShopCatalog::standard());
+
+// ========================
+// HELPER FUNCTIONS
+// ========================
+// Formats a number with commas (e.g., 1000000 -> 1,000,000); see formatNumber
+// for the allocation-free version
+std::string formatWithCommas(const BigNumber& value);
+// Formats a duration in seconds (e.g., 3723 -> 1h 02m 03s)
+std::string formatDuration(double seconds);
+
+} // End of namespace piegame
@@ -0,0 +1,199 @@
+#include "InputJournal.h"
+#include "SaveFile.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace piegame {
+
+namespace {
+
+const char JOURNAL_MAGIC[4] = { 'P', 'I', 'E', 'J' };
+const size_t JOURNAL_HEADER_SIZE = 16; // Keeps the starting save 8-byte aligned
+const uint32_t MAX_MICROS = 0x7FFFFFFF;
+
+// magic, version, starting save size, unused
+void writeHeader(unsigned char* out, uint32_t saveSize) {
+    uint32_t fields[3] = { JOURNAL_VERSION, saveSize, 0 };
+    std::memcpy(out, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC));
+    std::memcpy(out + 4, fields, sizeof(fields));
+}
+
+} // namespace
+
+uint32_t journalMicros(float deltaTime) {
+    if (!(deltaTime > 0.0f)) return 0;
+    double micros = std::round((double)deltaTime * 1e6);
+    return micros >= MAX_MICROS ? MAX_MICROS : (uint32_t)micros;
+}
+
+float journalDeltaTime(uint32_t micros) {
+    return (float)(micros / 1e6);
+}
+
+// ========================
+// RECORDING
+// ========================
+bool JournalWriter::begin(const std::string& path, const std::string& startSavePath) {
+    close();
+    std::vector<unsigned char> save;
+    if (!startSavePath.empty()) {
+        if (std::FILE* in = std::fopen(startSavePath.c_str(), "rb")) {
+            unsigned char chunk[4096];
+            size_t n;
+            while ((n = std::fread(chunk, 1, sizeof(chunk), in)) > 0) save.insert(save.end(), chunk, chunk + n);
+            std::fclose(in);
+        }
+    }
+
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+    unsigned char header[JOURNAL_HEADER_SIZE];
+    writeHeader(header, (uint32_t)save.size());
+    bool ok = std::fwrite(header, sizeof(header), 1, file) == 1 &&
+              (save.empty() || std::fwrite(save.data(), save.size(), 1, file) == 1);
+    if (!ok) close();
+    frameCount = 0;
+    sinceFlush = 0.0f;
+    return ok;
+}
+
+void JournalWriter::put(uint32_t value) {
+    while (value >= 0x80) {
+        pending.push_back(uint8_t(value | 0x80));
+        value >>= 7;
+    }
+    pending.push_back(uint8_t(value));
+}
+
+bool JournalWriter::apply(Simulation& sim, const Action& action) {
+    uint32_t code = (uint32_t)action.type << 8;
+    if (action.index != 0) code |= JOURNAL_SLOT_FOLLOWS;
+    if (action.count != 1) code |= JOURNAL_COUNT_FOLLOWS;
+    put((code << 1) | 1);
+    if (action.index != 0) put((uint32_t)action.index);
+    if (action.count != 1) put(action.count == BUY_MAX ? 0 : (uint32_t)action.count);
+    return sim.apply(action);
+}
+
+void JournalWriter::step(Simulation& sim, float deltaTime) {
+    uint32_t micros = journalMicros(deltaTime);
+    put(micros << 1);
+    frameCount++;
+    float recorded = journalDeltaTime(micros);
+    sim.step(recorded);
+
+    // Flushed once a second, so a crash or a closed console loses at most that
+    sinceFlush += recorded;
+    if (sinceFlush >= 1.0f) flush();
+}
+
+void JournalWriter::startRun(Simulation& sim) {
+    put((JOURNAL_START_RUN << 1) | 1);
+    sim.startRun();
+}
+
+void JournalWriter::flush() {
+    sinceFlush = 0.0f;
+    if (!file) return;
+    if (!pending.empty()) std::fwrite(pending.data(), 1, pending.size(), file);
+    pending.clear();
+    std::fflush(file);
+}
+
+void JournalWriter::close() {
+    if (!file) return;
+    flush();
+    std::fclose(file);
+    file = nullptr;
+}
+
+// ========================
+// REPLAY
+// ========================
+bool Journal::load(const std::string& path) {
+    bytes.clear();
+    saveSize = entriesAt = 0;
+    version = 0;
+    std::FILE* in = std::fopen(path.c_str(), "rb");
+    if (!in) return false;
+    std::fseek(in, 0, SEEK_END);
+    long size = std::ftell(in);
+    std::fseek(in, 0, SEEK_SET);
+    if (size >= (long)JOURNAL_HEADER_SIZE) {
+        bytes.resize((size_t)size);
+        if (std::fread(bytes.data(), 1, bytes.size(), in) != bytes.size()) bytes.clear();
+    }
+    std::fclose(in);
+
+    uint32_t fields[3] = {};
+    if (bytes.size() >= JOURNAL_HEADER_SIZE) std::memcpy(fields, bytes.data() + 4, sizeof(fields));
+    bool valid = bytes.size() >= JOURNAL_HEADER_SIZE &&
+                 std::memcmp(bytes.data(), JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) == 0 &&
+                 fields[0] >= 1 && fields[0] <= JOURNAL_VERSION &&
+                 fields[1] <= bytes.size() - JOURNAL_HEADER_SIZE;
+    if (!valid) {
+        bytes.clear();
+        return false;
+    }
+    version = fields[0];
+    saveSize = fields[1];
+    entriesAt = JOURNAL_HEADER_SIZE + saveSize;
+    return true;
+}
+
+bool Journal::replay(Simulation& sim, Stats* stats, uint64_t maxFrames) const {
+    Stats counted;
+    if (saveSize > 0) {
+        SaveFile start;
+        if (!start.openBytes(bytes.data() + JOURNAL_HEADER_SIZE, saveSize) || start.games() != 1 ||
+            !start.restore(0, sim)) {
+            return false;
+        }
+    }
+
+    const uint8_t* p = bytes.data() + entriesAt;
+    const uint8_t* end = bytes.data() + bytes.size();
+    double seconds = 0.0;
+    // One varint; false if the journal is cut off in the middle of it
+    auto next = [&](uint32_t& value) {
+        value = 0;
+        int shift = 0;
+        while (p < end && (*p & 0x80) && shift < 28) {
+            value |= uint32_t(*p++ & 0x7F) << shift;
+            shift += 7;
+        }
+        if (p == end) return false;
+        value |= uint32_t(*p++) << shift;
+        return true;
+    };
+
+    while (p < end && counted.frames < maxFrames) {
+        uint32_t value;
+        if (!next(value)) break; // Cut off mid-entry: the session ended there
+
+        if ((value & 1) == 0) {
+            float deltaTime = journalDeltaTime(value >> 1);
+            sim.step(deltaTime);
+            seconds += deltaTime;
+            counted.frames++;
+        } else if ((value >> 1) == JOURNAL_START_RUN) {
+            sim.startRun();
+            counted.runs++;
+        } else {
+            uint32_t code = value >> 1;
+            uint32_t slot = 0, count = 1;
+            if (version < 3) slot = code & 0xFF; // Older journals keep the slot in the event
+            else if ((code & JOURNAL_SLOT_FOLLOWS) && !next(slot)) break;
+            if ((code & JOURNAL_COUNT_FOLLOWS) && !next(count)) break;
+            code &= ~(JOURNAL_COUNT_FOLLOWS | JOURNAL_SLOT_FOLLOWS);
+            sim.apply({ (ActionType)(code >> 8), (int)slot, count == 0 ? BUY_MAX : (int)count });
+            counted.actions++;
+        }
+    }
+    counted.seconds = seconds;
+    if (stats) *stats = counted;
+    return true;
+}
+
+} // End of namespace piegame
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "Simulation.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace piegame {
+
+// ========================
+// INPUT JOURNAL
+// ========================
+// A session recorded as the inputs that drove it: every action, every new
+// run and every frame's deltaTime, in order. The simulation has no other
+// inputs (no clock, no rand()), so replaying a journal into a Simulation
+// rebuilds the exact same game, as fast as the CPU allows.
+//
+// File layout: a 16-byte header ("PIEJ", version, starting save size),
+// the starting save (a SaveFile image, empty for a fresh game), then the
+// entries. Each entry is one varint:
+//   even:  a frame; value >> 1 is its deltaTime in whole microseconds
+//   odd:   an event; value >> 1 is JOURNAL_START_RUN, or ActionType << 8
+//          for an action, plus JOURNAL_SLOT_FOLLOWS when the next varint is
+//          its slot (left out for slot 0) and JOURNAL_COUNT_FOLLOWS when
+//          the varint after that is its count (0 for BUY_MAX)
+// A 30 FPS frame takes 3 bytes, a bake 1 and other actions 2 to 4, so an
+// hour of play is about 550 KB. Versions 1 (no counts) and 2 (the slot in
+// the low 8 bits of the event) still replay.
+const uint32_t JOURNAL_VERSION = 3;
+const uint32_t JOURNAL_START_RUN = 0xFFFF;
+const uint32_t JOURNAL_COUNT_FOLLOWS = 0x8000;
+const uint32_t JOURNAL_SLOT_FOLLOWS = 0x4000;
+
+// deltaTime as the journal keeps it. The recorder steps with this value too,
+// so the live game and its replay see bit-identical frame times.
+uint32_t journalMicros(float deltaTime);
+float journalDeltaTime(uint32_t micros);
+
+// ========================
+// RECORDING
+// ========================
+// Stands between the front end and its Simulation: every call is written to
+// the journal and then applied, so what was recorded is what happened.
+class JournalWriter {
+public:
+    JournalWriter() = default;
+    ~JournalWriter() { close(); }
+    JournalWriter(const JournalWriter&) = delete;
+    JournalWriter& operator=(const JournalWriter&) = delete;
+
+    // Starts a journal at `path`. If the session begins from a save, pass
+    // its path: the save is copied in so the journal stands on its own.
+    bool begin(const std::string& path, const std::string& startSavePath = "");
+
+    bool apply(Simulation& sim, const Action& action);
+    void step(Simulation& sim, float deltaTime);
+    void startRun(Simulation& sim);
+
+    // Writes buffered entries to the file (also done every second of play)
+    void flush();
+    void close();
+
+    uint64_t frames() const { return frameCount; }
+
+private:
+    std::FILE* file = nullptr;
+    std::vector<uint8_t> pending; // Entries not yet written
+    uint64_t frameCount = 0;
+    float sinceFlush = 0.0f;
+
+    void put(uint32_t value);
+};
+
+// ========================
+// REPLAY
+// ========================
+// A whole journal in memory
+class Journal {
+public:
+    // False if the file is missing, from another version, or cut short
+    bool load(const std::string& path);
+
+    bool startsFromSave() const { return saveSize > 0; }
+    size_t entryBytes() const { return bytes.size() - entriesAt; }
+
+    struct Stats {
+        uint64_t frames = 0;
+        uint64_t actions = 0;
+        uint64_t runs = 0;
+        double seconds = 0.0; // Game time covered
+    };
+
+    // Replays into sim, which should be newly constructed (a starting save
+    // overwrites it, a fresh game starts from its default state). Stops
+    // after `maxFrames` frames (to look at the game as it was at a reported
+    // moment). False if the starting save does not fit sim's catalog.
+    bool replay(Simulation& sim, Stats* stats = nullptr, uint64_t maxFrames = UINT64_MAX) const;
+
+private:
+    std::vector<uint8_t> bytes;
+    size_t saveSize = 0;
+    size_t entriesAt = 0;
+    uint32_t version = 0;
+};
+
+} // End of namespace piegame
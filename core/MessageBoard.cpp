@@ -0,0 +1,119 @@
+#include "MessageBoard.h"
+
+#include <algorithm>
+
+namespace piegame {
+
+void MessageBoard::show(const std::string& text, float duration, MessagePriority priority) {
+    auto known = byText.find(text);
+    if (known != byText.end()) {
+        // A repeat: count it, and give it its full time from now
+        Message& m = messages[known->second];
+        m.repeats++;
+        m.duration = std::max(m.duration, duration);
+        if (m.shown) {
+            m.due = wheel.schedule(known->second, m.duration);
+            changes++;
+        }
+        return;
+    }
+
+    uint32_t id;
+    if (freeIds.empty()) {
+        id = (uint32_t)messages.size();
+        messages.emplace_back();
+    } else {
+        id = freeIds.back();
+        freeIds.pop_back();
+    }
+    Message& m = messages[id];
+    m.text = text;
+    m.repeats = 1;
+    m.duration = duration;
+    m.priority = priority;
+    m.shown = false;
+    byText[text] = id;
+
+    if ((int)shown.size() < MESSAGE_LINES) {
+        display(id);
+        return;
+    }
+    // Lines are in rank order, so the last one is the one to bump if any
+    Message& lowest = messages[shown.back()];
+    if (lowest.priority < priority) {
+        lowest.shown = false; // Its timer entry goes stale
+        queue[(int)lowest.priority].push_front(shown.back());
+        shown.pop_back();
+        display(id);
+        return;
+    }
+    queue[(int)priority].push_back(id);
+}
+
+void MessageBoard::update(float dt) {
+    wheel.advance(dt, [this](uint32_t id, TimerWheel::Tick due) { expire(id, due); });
+}
+
+void MessageBoard::clear() {
+    wheel.clear();
+    messages.clear();
+    freeIds.clear();
+    shown.clear();
+    for (auto& waiting : queue) waiting.clear();
+    byText.clear();
+    changes++;
+}
+
+std::string MessageBoard::lineText(int line) const {
+    const Message& m = messages[shown[line]];
+    if (m.repeats == 1) return m.text;
+    return m.text + " (x" + std::to_string(m.repeats) + ")";
+}
+
+size_t MessageBoard::waiting() const {
+    size_t count = 0;
+    for (const auto& waiting : queue) count += waiting.size();
+    return count;
+}
+
+float MessageBoard::secondsUntilChange() const {
+    TimerWheel::Tick first = messages[shown[0]].due;
+    for (uint32_t id : shown) first = std::min(first, messages[id].due);
+    return (float)wheel.secondsUntil(first);
+}
+
+// Puts a message on a line, in rank order, and starts its time
+void MessageBoard::display(uint32_t id) {
+    Message& m = messages[id];
+    m.shown = true;
+    m.order = ++arrivals;
+    m.due = wheel.schedule(id, m.duration);
+    auto at = std::find_if(shown.begin(), shown.end(), [&](uint32_t other) {
+        return messages[other].priority < m.priority;
+    });
+    shown.insert(at, id);
+    changes++;
+}
+
+void MessageBoard::expire(uint32_t id, TimerWheel::Tick due) {
+    Message& m = messages[id];
+    if (!m.shown || m.due != due) return; // Repeated or bumped since
+
+    shown.erase(std::find(shown.begin(), shown.end(), id));
+    byText.erase(m.text);
+    m.shown = false;
+    m.text.clear();
+    freeIds.push_back(id);
+    changes++;
+
+    // The freed line goes to the best waiting message
+    for (int p = (int)MessagePriority::High; p >= (int)MessagePriority::Low; --p) {
+        if (queue[p].empty()) continue;
+        uint32_t next = queue[p].front();
+        queue[p].pop_front();
+        display(next);
+        break;
+    }
+}
+
+} // End of namespace piegame
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "TimerWheel.h"
+
+namespace piegame {
+
+// ========================
+// MESSAGE BOARD
+// ========================
+// The messages under the main screen and the intro: a few lines at once,
+// each for its own duration. Nothing shown is ever lost:
+//   - the same text again while it is up (or waiting) counts as a repeat,
+//     "Grandma purchased! (x3)", and starts its time over
+//   - with every line taken, a new message waits its turn, unless it
+//     outranks a line on display: that one goes back to the head of the
+//     queue and comes up again later for its full time
+//   - a freed line goes to the oldest waiting message of the highest rank
+// Expiry runs on a TimerWheel, so showing or expiring a message is O(1)
+// however many are queued. version() changes with every change to the
+// lines, which is all a renderer needs to know to redraw them.
+enum class MessagePriority : uint8_t {
+    Low,    // Purchases
+    Normal, // Tips
+    High    // Intro milestones
+};
+
+const int MESSAGE_LINES = 3;               // Lines on display at once
+const float MESSAGE_DURATION = 5.0f;       // Default seconds on display
+const double MESSAGE_RESOLUTION = 0.01;    // Seconds per timer wheel tick
+
+class MessageBoard {
+public:
+    MessageBoard() : wheel(MESSAGE_RESOLUTION) {}
+
+    // Shows text for `duration` seconds once it is on display
+    void show(const std::string& text, float duration = MESSAGE_DURATION,
+              MessagePriority priority = MessagePriority::Normal);
+
+    // Runs the clock: expires lines and brings waiting messages up
+    void update(float dt);
+
+    // Drops everything, shown and waiting
+    void clear();
+
+    // Is any line on display?
+    bool active() const { return !shown.empty(); }
+
+    // Lines on display, highest rank first, then in the order they came up
+    int lineCount() const { return (int)shown.size(); }
+    std::string lineText(int line) const;
+
+    // Messages waiting for a line
+    size_t waiting() const;
+
+    // Changes whenever the lines on display do
+    uint64_t version() const { return changes; }
+
+    // Seconds until the first line on display runs out (only while active())
+    float secondsUntilChange() const;
+
+private:
+    struct Message {
+        std::string text;
+        int repeats = 1;
+        float duration = 0.0f;
+        MessagePriority priority = MessagePriority::Normal;
+        uint64_t order = 0;         // When it came up, for lines of equal rank
+        TimerWheel::Tick due = 0;   // Expiry that still counts, while shown
+        bool shown = false;
+    };
+
+    TimerWheel wheel;
+    std::vector<Message> messages;    // By id; free ids are reused
+    std::vector<uint32_t> freeIds;
+    std::vector<uint32_t> shown;      // Ids on display, in line order
+    std::deque<uint32_t> queue[3];    // Waiting ids, per priority
+    std::unordered_map<std::string, uint32_t> byText; // Shown or waiting
+    uint64_t changes = 0;
+    uint64_t arrivals = 0;
+
+    void display(uint32_t id);
+    void expire(uint32_t id, TimerWheel::Tick due);
+};
+
+} // End of namespace piegame
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "GameCore.h"
+
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace piegame {
+
+// ========================
+// PRESTIGE UPGRADE CATALOG
+// ========================
+// Each prestige upgrade is a policy type: a name plus static functions of the
+// shop and the cats. PrestigeCatalog lists them in shop order (slot 0 is
+// [1] in the shop). Looking up a slot expands at compile time into a chain of
+// comparisons that call the policy directly, so pricing, buying and showing
+// an upgrade are plain inlinable calls: no std::function, no captured
+// pointers, nothing on the heap.
+//
+// To add an upgrade, write a policy like the ones below and append it to
+// PrestigeCatalog.
+
+struct BoostUpgrade {
+    static constexpr const char* name = "Boost%";
+    static constexpr int cost(const PrestigeShop&, const CatSystem&) { return 1; }
+    static constexpr bool visible(const PrestigeShop&, const CatSystem&) { return true; }
+    static void apply(PrestigeShop& shop, CatSystem&) { shop.boostPercent++; }
+    static std::string describe(const PrestigeShop& shop, const CatSystem&) {
+        return "Increase building outputs and click power by 1% (Current: " + std::to_string(shop.boostPercent) + "%)";
+    }
+};
+
+struct MilkUpgrade {
+    static constexpr const char* name = "Milk";
+    static constexpr int cost(const PrestigeShop& shop, const CatSystem& cats) {
+        return shop.prices.milkBase + cats.milkPurchased * shop.prices.milkStep;
+    }
+    static constexpr bool visible(const PrestigeShop&, const CatSystem&) { return true; }
+    static void apply(PrestigeShop&, CatSystem& cats) { cats.milkPurchased++; }
+    static std::string describe(const PrestigeShop&, const CatSystem& cats) {
+        return "Attracts cats to reduce rats (Owned: " + std::to_string(cats.milkPurchased) +
+               ", Cats: " + std::to_string(cats.getTotalCats()) + ")";
+    }
+};
+
+struct CatnipUpgrade {
+    static constexpr const char* name = "Catnip";
+    static constexpr int cost(const PrestigeShop& shop, const CatSystem& cats) {
+        return shop.prices.catnipBase + cats.catnipLevel * shop.prices.catnipStep;
+    }
+    static constexpr bool visible(const PrestigeShop&, const CatSystem&) { return true; }
+    static void apply(PrestigeShop&, CatSystem& cats) { cats.catnipLevel++; }
+    static std::string describe(const PrestigeShop&, const CatSystem& cats) {
+        return "Increases cat hungriness (Level: " + std::to_string(cats.catnipLevel) + ")";
+    }
+};
+
+struct GoldenSwordUpgrade {
+    static constexpr const char* name = "Golden Sword";
+    static constexpr int cost(const PrestigeShop&, const CatSystem&) { return 999; }
+    static constexpr bool visible(const PrestigeShop& shop, const CatSystem&) { return !shop.hasGoldenSword; }
+    static void apply(PrestigeShop& shop, CatSystem&) { shop.hasGoldenSword = true; }
+    static std::string describe(const PrestigeShop&, const CatSystem&) {
+        return "Purely cosmetic flex (Limited edition!)";
+    }
+};
+
+// A compile-time list of upgrade policies
+template <typename... Upgrades>
+struct UpgradeList {
+    static constexpr int size = sizeof...(Upgrades);
+
+    // Calls f(Upgrade{}) with the policy in `slot`. Returns false (and calls
+    // nothing) if there is no such slot.
+    template <typename F>
+    static bool visit(int slot, F&& f) {
+        return visit(slot, f, std::index_sequence_for<Upgrades...>{});
+    }
+
+    // Slot of an upgrade policy, for code that wants a specific upgrade
+    template <typename Upgrade>
+    static constexpr int slotOf() {
+        int slot = -1;
+        int i = 0;
+        ((slot = (slot < 0 && std::is_same<Upgrade, Upgrades>::value) ? i : slot, ++i), ...);
+        return slot;
+    }
+
+private:
+    template <typename F, size_t... Slots>
+    static bool visit(int slot, F& f, std::index_sequence<Slots...>) {
+        return ((slot == (int)Slots ? (f(Upgrades{}), true) : false) || ...);
+    }
+};
+
+typedef UpgradeList<BoostUpgrade, MilkUpgrade, CatnipUpgrade, GoldenSwordUpgrade> PrestigeCatalog;
+
+// Shortcuts over PrestigeCatalog by slot
+
+inline const char* prestigeUpgradeName(int slot) {
+    const char* name = "";
+    PrestigeCatalog::visit(slot, [&](auto upgrade) { name = decltype(upgrade)::name; });
+    return name;
+}
+
+// Cost in stars, or -1 for a slot that does not exist
+inline int prestigeUpgradeCost(int slot, const PrestigeShop& shop, const CatSystem& cats) {
+    int cost = -1;
+    PrestigeCatalog::visit(slot, [&](auto upgrade) { cost = decltype(upgrade)::cost(shop, cats); });
+    return cost;
+}
+
+inline bool prestigeUpgradeVisible(int slot, const PrestigeShop& shop, const CatSystem& cats) {
+    bool visible = false;
+    PrestigeCatalog::visit(slot, [&](auto upgrade) { visible = decltype(upgrade)::visible(shop, cats); });
+    return visible;
+}
+
+inline std::string prestigeUpgradeDescription(int slot, const PrestigeShop& shop, const CatSystem& cats) {
+    std::string text;
+    PrestigeCatalog::visit(slot, [&](auto upgrade) { text = decltype(upgrade)::describe(shop, cats); });
+    return text;
+}
+
+// Applies the upgrade's effect (the caller has already taken the stars)
+inline void applyPrestigeUpgrade(int slot, PrestigeShop& shop, CatSystem& cats) {
+    PrestigeCatalog::visit(slot, [&](auto upgrade) { decltype(upgrade)::apply(shop, cats); });
+}
+
+} // End of namespace piegame
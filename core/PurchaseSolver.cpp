@@ -0,0 +1,404 @@
+#include "PurchaseSolver.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <unordered_map>
+
+namespace piegame {
+
+namespace {
+
+const double NEVER = std::numeric_limits<double>::infinity();
+
+// A shop slot as the solver sees it
+struct Item {
+    int slot;
+    int row;              // The building's row (for upgrades: the row they multiply)
+    bool building;
+    double cost = 0.0;    // Upgrades only; building prices follow the count
+    float multiplier = 1.0f;
+    int prerequisite = -1; // Index in the item list, -1 if none
+};
+
+// A way of reaching a shop state: when, with how many pies left, and the
+// purchase that led here (parent is an index into the node list)
+struct Node {
+    int parent;
+    int item;
+    double seconds;
+    double pies;
+    bool rising;       // Pies still going up here (above the rat equilibrium they fall)
+    double optimistic; // seconds + lowerBound(pies)
+};
+
+class Search {
+public:
+    Search(const Simulation& sim, double target, const SolverOptions& options);
+    PurchasePlan run();
+
+private:
+    const Simulation& sim;
+    const BuildingTable& table;
+    double target;
+    SolverOptions options;
+    double clickRate;   // Pies per second from SPACE
+    double boostFactor; // Boost% as a factor
+
+    std::vector<Item> items;
+    std::vector<std::vector<int>> rowUpgrades; // Per row, its upgrades' item indices
+    std::vector<char> boughtAtStart;  // Per item (upgrades)
+    std::vector<int> counts;          // Per row, for the state being expanded
+    std::vector<float> multipliers;   // Per row
+    std::vector<double> rowOutput;    // Per row, pies/sec
+    std::vector<char> bought;         // Per item
+    double pps = 0.0;
+
+    // Every node kept, and the states of the layer being built: the key is
+    // the counts and upgrades, the value the nodes no other node covers
+    std::vector<Node> nodes;
+    using Layer = std::unordered_map<std::string, std::vector<int>>;
+    double bestSeconds = NEVER;
+    int bestNode = -1;
+    long long expanded = 0;
+    std::vector<std::pair<double, int>> costScratch;
+    // Per row: extra buildings within S solve a*n^2 + b*n <= S
+    struct Bound { double a, b, count, pps; };
+    std::vector<Bound> boundScratch;
+
+    double outputOf(int row, int count, float multiplier) const {
+        return count > 0 ? table.outputFor(row, count, multiplier).toDouble() : 0.0;
+    }
+    double buildingCost(int row) const {
+        long long base = table.row(row).baseCost;
+        return (double)(base + (long long)counts[row] * base / 2);
+    }
+    double timeBetween(double from, double to) const {
+        return timeBetweenPies(sim.game.ratSystem, sim.catSystem, pps, clickRate, from, to);
+    }
+    // timeBetween() without the rats: never more, and no integration
+    double ratFreeTime(double from, double to) const {
+        return to <= from ? 0.0 : (to - from) / (pps + clickRate);
+    }
+
+    double lowerBound(double pies);
+    std::string stateKey() const;
+    void loadState(const std::string& key);
+    void refreshOutput();
+    void toggle(int item, bool on);
+    bool covers(const Node& from, const Node& to) const;
+    void add(Layer& layer, int parent, int item, double seconds, double pies);
+    void expand(int node, Layer& next);
+    void greedyDive();
+    bool reachable() const;
+};
+
+Search::Search(const Simulation& s, double t, const SolverOptions& o)
+    : sim(s), table(s.buildings), target(t), options(o) {
+    int boost = sim.prestigeShop.boostPercent;
+    clickRate = options.clicksPerSecond * (1 + boost / 100); // As BakePie adds them
+    boostFactor = (100 + boost) / 100.0;
+
+    // Buildings and upgrades from the shop, in shop order
+    for (int slot = 0; slot < (int)sim.shopItems.size(); ++slot) {
+        const ShopItem* shopItem = sim.shopItems[slot].get();
+        if (const Building* b = dynamic_cast<const Building*>(shopItem)) {
+            items.push_back({ slot, b->getRow(), true });
+        }
+    }
+    for (int slot = 0; slot < (int)sim.shopItems.size(); ++slot) {
+        const Upgrade* u = dynamic_cast<const Upgrade*>(sim.shopItems[slot].get());
+        if (!u || !u->getTarget()) continue;
+        Item item{ slot, u->getTarget()->getRow(), false, u->getCost().toDouble(), u->getMultiplier() };
+        items.push_back(item);
+    }
+    boughtAtStart.assign(items.size(), 0);
+    for (size_t i = 0; i < items.size(); ++i) {
+        if (items[i].building) continue;
+        const Upgrade* u = static_cast<const Upgrade*>(sim.shopItems[items[i].slot].get());
+        boughtAtStart[i] = u->isPurchased();
+        for (size_t j = 0; j < items.size(); ++j) {
+            if (sim.shopItems[items[j].slot].get() == u->getPrerequisite()) items[i].prerequisite = (int)j;
+        }
+    }
+    rowUpgrades.resize(table.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+        if (!items[i].building) rowUpgrades[items[i].row].push_back((int)i);
+    }
+    for (int row = 0; row < table.size(); ++row) counts.push_back(table.row(row).count);
+    bought = boughtAtStart;
+    multipliers.resize(table.size());
+    rowOutput.resize(table.size());
+    refreshOutput();
+}
+
+// Seconds this node needs at the very least. No plan that has spent S more
+// pies makes more than R(S) pies/sec, where R gives every building type the
+// whole of S and takes every upgrade S covers as owned. Pies made from here
+// on (spent or not) therefore grow no faster than R(pies made), and take at
+// least the integral of 1 / R to reach the target; each step of the sum uses
+// R at its far end. Rats only slow things down, so they are left out.
+double Search::lowerBound(double pies) {
+    if (pies >= target) return 0.0;
+
+    // Every row counts, or R(S) comes out low and the bound prunes the best
+    // plan (prices are base + (count + i) * base / 2, taken one pie low for
+    // the int halving)
+    std::vector<Bound>& bounds = boundScratch;
+    int rows = table.size();
+    bounds.resize(rows);
+    for (int row = 0; row < rows; ++row) {
+        double base = table.row(row).baseCost;
+        bounds[row] = { base / 4.0, base - 1.0 + base * counts[row] / 2.0 - base / 4.0, (double)counts[row],
+                        table.row(row).basePps * multipliers[row] * boostFactor };
+    }
+
+    const int STEPS = 24;
+    double seconds = 0.0, from = pies;
+    for (int k = 1; k <= STEPS; ++k) {
+        double fraction = (double)k / STEPS;
+        double to = pies + (target - pies) * fraction * fraction; // Finer steps early, where R climbs fastest
+        double rate = 0.0;
+        for (int row = 0; row < rows; ++row) {
+            const Bound& r = bounds[row];
+            double extra = std::floor((-r.b + std::sqrt(r.b * r.b + 4.0 * r.a * to)) / (2.0 * r.a));
+            double multiplier = 1.0;
+            for (int i : rowUpgrades[row]) {
+                if (!bought[i] && items[i].cost <= to) multiplier *= items[i].multiplier;
+            }
+            rate += r.pps * (r.count + std::max(extra, 0.0)) * multiplier;
+        }
+        rate = rate * (1.0 + 1e-6) + clickRate; // Float rounding in the game's own product
+        if (rate <= 0.0) return NEVER;
+        seconds += (to - from) / rate;
+        from = to;
+    }
+    return seconds;
+}
+
+std::string Search::stateKey() const {
+    std::string key(reinterpret_cast<const char*>(counts.data()), counts.size() * sizeof(int));
+    key.append(bought.begin(), bought.end());
+    return key;
+}
+
+void Search::loadState(const std::string& key) {
+    std::copy(key.begin(), key.begin() + counts.size() * sizeof(int), reinterpret_cast<char*>(counts.data()));
+    std::copy(key.begin() + counts.size() * sizeof(int), key.end(), bought.begin());
+    refreshOutput();
+}
+
+// Multipliers and outputs for the current counts and upgrades; upgrades
+// multiply in shop order, which their prerequisites make the buying order
+void Search::refreshOutput() {
+    for (int row = 0; row < table.size(); ++row) multipliers[row] = table.row(row).multiplier;
+    for (size_t i = 0; i < items.size(); ++i) {
+        if (bought[i] && !boughtAtStart[i]) multipliers[items[i].row] *= items[i].multiplier;
+    }
+    pps = 0.0;
+    for (int row = 0; row < table.size(); ++row) {
+        rowOutput[row] = outputOf(row, counts[row], multipliers[row]);
+        pps += rowOutput[row];
+    }
+}
+
+// Buys (or hands back) one item
+void Search::toggle(int i, bool on) {
+    if (items[i].building) counts[items[i].row] += on ? 1 : -1;
+    else bought[i] = on;
+    refreshOutput();
+}
+
+// Same shop, same pies/sec: a node that can wait its way to the other's
+// pie count by the other's time does everything the other can
+bool Search::covers(const Node& from, const Node& to) const {
+    if (from.pies >= to.pies) return from.rising && from.seconds <= to.seconds;
+    if (from.seconds + ratFreeTime(from.pies, to.pies) > to.seconds) return false;
+    return from.seconds + timeBetween(from.pies, to.pies) <= to.seconds;
+}
+
+// Adds a node for the current state to the layer, unless it cannot beat
+// the best plan or one there covers it
+void Search::add(Layer& layer, int parent, int item, double seconds, double pies) {
+    Node node{ parent, item, seconds, pies, false, 0.0 };
+    node.rising = pies < sim.game.ratSystem.getThreshold() || std::isfinite(timeBetween(pies, pies + 1.0));
+
+    std::vector<int>& kept = layer[stateKey()];
+    for (int other : kept) {
+        if (covers(nodes[other], node)) return;
+    }
+    node.optimistic = seconds + lowerBound(pies);
+    if (node.optimistic >= bestSeconds) return;
+    kept.erase(std::remove_if(kept.begin(), kept.end(), [&](int other) {
+        return covers(node, nodes[other]);
+    }), kept.end());
+    kept.push_back((int)nodes.size());
+    nodes.push_back(node);
+}
+
+// Everything that can be bought next from a node (in the current state),
+// each bought the moment it is affordable
+void Search::expand(int index, Layer& next) {
+    ++expanded;
+    Node node = nodes[index]; // nodes may grow below
+    if (node.optimistic >= bestSeconds) return;
+    if (node.seconds + ratFreeTime(node.pies, target) < bestSeconds) {
+        double finish = node.seconds + timeBetween(node.pies, target);
+        if (finish < bestSeconds) {
+            bestSeconds = finish;
+            bestNode = index;
+        }
+    }
+
+    // Cheapest first, so each wait carries on from the one before (one
+    // march up the rat-aware flow rather than one per item)
+    std::vector<std::pair<double, int>>& costs = costScratch;
+    costs.clear();
+    for (int i = 0; i < (int)items.size(); ++i) {
+        const Item& item = items[i];
+        if (item.building) {
+            if (counts[item.row] >= INT_MAX / 2) continue;
+            costs.push_back({ buildingCost(item.row), i });
+        } else {
+            if (bought[i] || (item.prerequisite >= 0 && !bought[item.prerequisite])) continue;
+            costs.push_back({ item.cost, i });
+        }
+    }
+    std::sort(costs.begin(), costs.end());
+
+    double when = node.seconds, pies = node.pies;
+    for (const auto& entry : costs) {
+        double cost = entry.first;
+        if (cost > pies) {
+            when += timeBetween(pies, cost);
+            pies = cost;
+        }
+        if (when >= bestSeconds) break;
+
+        toggle(entry.second, true);
+        add(next, index, entry.second, when, std::max(node.pies, cost) - cost);
+        toggle(entry.second, false);
+    }
+}
+
+// A first plan to measure the rest against: keep buying whatever adds the
+// most pies/sec per pie, as long as waiting for the target is not sooner
+void Search::greedyDive() {
+    double seconds = 0.0, pies = nodes[0].pies;
+    int parent = 0;
+    while (seconds < bestSeconds) {
+        double finish = seconds + timeBetween(pies, target);
+        if (finish < bestSeconds) {
+            bestSeconds = finish;
+            bestNode = parent;
+        }
+        int pick = -1;
+        double pickCost = 0.0, pickRatio = 0.0;
+        for (int i = 0; i < (int)items.size(); ++i) {
+            const Item& item = items[i];
+            double cost, gain;
+            if (item.building) {
+                cost = buildingCost(item.row);
+                gain = outputOf(item.row, counts[item.row] + 1, multipliers[item.row]) - rowOutput[item.row];
+            } else {
+                if (bought[i] || (item.prerequisite >= 0 && !bought[item.prerequisite])) continue;
+                cost = item.cost;
+                gain = outputOf(item.row, counts[item.row], multipliers[item.row] * item.multiplier) - rowOutput[item.row];
+            }
+            if (gain / cost > pickRatio) {
+                pick = i;
+                pickCost = cost;
+                pickRatio = gain / cost;
+            }
+        }
+        if (pick < 0) break;
+        double wait = timeBetween(pies, pickCost);
+        if (!std::isfinite(wait)) break;
+        seconds += wait;
+        pies = std::max(pies, pickCost) - pickCost;
+        toggle(pick, true);
+        nodes.push_back({ parent, pick, seconds, pies, true, 0.0 });
+        parent = (int)nodes.size() - 1;
+    }
+}
+
+// Rats grow hungrier with the pies/sec they feed on: each eats 1 + k*pps a
+// second. With rats * k >= 1 at the target no number of buildings outruns
+// them there (cats aside), and the target can never be reached.
+bool Search::reachable() const {
+    const RatSystem& rats = sim.game.ratSystem;
+    if (target < rats.getThreshold()) return true;
+    double ratCount = std::floor(rats.ratCurve(target, sim.catSystem));
+    double k = rats.singleRatCurve(target, 1.0) - rats.singleRatCurve(target, 0.0);
+    return ratCount * k < 1.0;
+}
+
+PurchasePlan Search::run() {
+    PurchasePlan plan;
+    plan.seconds = NEVER;
+    if (!reachable()) {
+        plan.optimal = true;
+        return plan;
+    }
+
+    std::string start = stateKey();
+    nodes.push_back({ -1, -1, 0.0, sim.game.totalPies.toDouble() + sim.game.pendingPies(), true, 0.0 });
+    greedyDive();
+    loadState(start);
+
+    // Layer k holds the states k purchases in. A state's purchase count is
+    // fixed (its buildings plus upgrades), so once layer k is complete each
+    // of its states is expanded once, from the nodes no other node covers.
+    // Past beamWidth nodes, a layer keeps the ones with the soonest optimistic
+    // finish, and the plan is no longer proven best.
+    Layer layer, next;
+    layer[start].push_back(0);
+    std::vector<std::pair<const std::string*, int>> open;
+    bool cut = false, trimmed = false;
+    while (!layer.empty() && !cut) {
+        open.clear();
+        for (const auto& state : layer) {
+            for (int index : state.second) open.push_back({ &state.first, index });
+        }
+        if (options.beamWidth > 0 && open.size() > options.beamWidth) {
+            std::nth_element(open.begin(), open.begin() + options.beamWidth, open.end(), [&](const auto& a, const auto& b) {
+                return nodes[a.second].optimistic < nodes[b.second].optimistic;
+            });
+            open.resize(options.beamWidth);
+            trimmed = true;
+        }
+
+        next.clear();
+        for (const auto& entry : open) {
+            if (expanded >= options.maxNodes) {
+                cut = true;
+                break;
+            }
+            loadState(*entry.first);
+            expand(entry.second, next);
+        }
+        std::swap(layer, next);
+    }
+
+    plan.seconds = bestSeconds;
+    plan.optimal = !cut && !trimmed;
+    plan.nodes = expanded;
+    for (int index = bestNode; index > 0; index = nodes[index].parent) {
+        plan.slots.push_back(items[nodes[index].item].slot);
+        plan.buyAt.push_back(nodes[index].seconds);
+    }
+    std::reverse(plan.slots.begin(), plan.slots.end());
+    std::reverse(plan.buyAt.begin(), plan.buyAt.end());
+    return plan;
+}
+
+} // namespace
+
+PurchasePlan solvePurchases(const Simulation& sim, double targetPies, const SolverOptions& options) {
+    Search search(sim, targetPies, options);
+    return search.run();
+}
+
+} // End of namespace piegame
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "FastForward.h"
+
+#include <vector>
+
+namespace piegame {
+
+// ========================
+// PURCHASE SOLVER
+// ========================
+// Finds the order of shop purchases that reaches a pie count soonest from a
+// game's current state. Each purchase is made as soon as it is affordable;
+// the search decides what to buy next, and when to stop buying and just wait.
+//
+// The model is the game's own: building prices rise by baseCost/2 per
+// building owned, upgrades multiply their building and need their
+// prerequisite bought first, and above the rat threshold the time to save
+// up comes from the same rat-aware flow as fastForward().
+//
+// Branch and bound, one layer per purchase made:
+//   - memo: a shop state (counts + upgrades) always sits in the same layer,
+//     and a way of reaching it that can wait its way to another's pie count
+//     by the other's time covers it, so each state is expanded once, from
+//     the ways nothing covers
+//   - bound: no plan spending S more pies makes more than R(S) pies/sec,
+//     where R gives every building type the whole of S and every upgrade,
+//     so pies grow no faster than R allows; a node that cannot beat the best
+//     plan even so is cut (R only overestimates, so nothing better is cut)
+//   - beam: past beamWidth nodes a layer keeps those with the soonest bound;
+//     the plan is then the best found, not proven best (in the plans
+//     checked, within 2% of a beam four times as wide)
+// A target above the pie count where rats outeat any number of buildings
+// (cats aside) is reported as never, without searching.
+struct SolverOptions {
+    double clicksPerSecond = 0.0;        // SPACE presses per second while waiting
+    size_t beamWidth = 500;              // Nodes kept per layer, 0 for all (exact, but slow past ~40,000 pies)
+    long long maxNodes = 5000000;        // Search budget; the best plan so far is returned past it
+};
+
+struct PurchasePlan {
+    std::vector<int> slots;      // Shop slots in buying order
+    std::vector<double> buyAt;   // Seconds from now of each purchase
+    double seconds = 0.0;        // Seconds until the target (infinity if never)
+    bool optimal = false;        // Proven best: no layer trimmed, and inside the node budget
+    long long nodes = 0;         // Search nodes expanded
+
+    // The next purchase, or -1 if waiting is best
+    int nextBuy() const { return slots.empty() ? -1 : slots.front(); }
+};
+
+PurchasePlan solvePurchases(const Simulation& sim, double targetPies, const SolverOptions& options = SolverOptions());
+
+} // End of namespace piegame
@@ -0,0 +1,325 @@
+#include "SaveFile.h"
+
+#include <cstring>
+#include <ctime>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace piegame {
+
+namespace {
+
+const char SAVE_MAGIC[4] = { 'P', 'I', 'E', 'S' };
+const uint32_t FNV_OFFSET = 2166136261u;
+const uint32_t FNV_PRIME = 16777619u;
+
+// FNV-1a over bytes, continuing from hash
+uint32_t fnv1a(uint32_t hash, const void* bytes, size_t n) {
+    const unsigned char* p = static_cast<const unsigned char*>(bytes);
+    for (size_t i = 0; i < n; ++i) {
+        hash ^= p[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+// Padded so that every record in a mapping starts where a SavedGame may
+size_t recordSize(uint32_t itemsPerGame) {
+    size_t bytes = sizeof(SavedGame) + itemsPerGame * sizeof(SavedItem);
+    return (bytes + alignof(SavedGame) - 1) / alignof(SavedGame) * alignof(SavedGame);
+}
+
+SavedNumber toSaved(const BigNumber& n) {
+    return { n.rawBits(), n.rawExponent(), 0 };
+}
+
+BigNumber fromSaved(const SavedNumber& n) {
+    return BigNumber::fromRaw(n.bits, n.exponent);
+}
+
+// Pushes the file to the disk itself, not just the OS cache
+bool syncFile(std::FILE* file) {
+    if (std::fflush(file) != 0) return false;
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+// Renames from over to in one step (rename() will not replace a file on Windows)
+bool replaceFile(const std::string& from, const std::string& to) {
+#ifdef _WIN32
+    return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
+} // namespace
+
+// ========================
+// SAVING
+// ========================
+SaveWriter::~SaveWriter() {
+    if (file) {
+        std::fclose(file);
+        std::remove(tempPath.c_str());
+    }
+}
+
+bool SaveWriter::begin(const std::string& target, uint64_t games, const ShopCatalog& catalog) {
+    const uint32_t itemsPerGame = (uint32_t)catalog.size();
+    path = target;
+    tempPath = target + ".tmp";
+    file = std::fopen(tempPath.c_str(), "wb");
+    if (!file) return false;
+
+    std::memcpy(header.magic, SAVE_MAGIC, sizeof(SAVE_MAGIC));
+    header.version = SAVE_VERSION;
+    header.headerSize = sizeof(SaveHeader);
+    header.recordSize = (uint32_t)recordSize(itemsPerGame);
+    header.games = games;
+    header.itemsPerGame = itemsPerGame;
+    header.checksum = 0; // Written by commit()
+    header.savedAt = (int64_t)std::time(nullptr);
+    header.catalogHash = catalog.layoutHash();
+    added = 0;
+    checksum = FNV_OFFSET;
+    failed = std::fwrite(&header, sizeof(header), 1, file) != 1;
+    items.resize(itemsPerGame);
+    return !failed;
+}
+
+bool SaveWriter::add(const Simulation& sim) {
+    if (!file || failed || added >= header.games || sim.shopItems.size() != header.itemsPerGame ||
+        sim.catalog().layoutHash() != header.catalogHash) {
+        failed = true;
+        return false;
+    }
+
+    SavedGame g{};
+    g.totalPies = toSaved(sim.game.totalPies);
+    g.piesPerSecond = toSaved(sim.game.piesPerSecond);
+    g.piesBakedThisRun = toSaved(sim.game.piesBakedThisRun);
+    g.ratsEating = toSaved(sim.game.ratSystem.getRatsEating());
+    g.ratsEatingSingle = sim.game.ratSystem.getRatsEatingSingle();
+    g.totalRats = sim.game.ratSystem.getTotalRats();
+    g.prestigeStars = sim.game.prestigeStars;
+    g.pieCarry = sim.game.pieCarry;
+    g.eatenCarry = sim.game.ratSystem.getEatenCarry();
+    g.untickedSeconds = sim.game.untickedSeconds;
+    g.milkPurchased = sim.catSystem.milkPurchased;
+    g.catnipLevel = sim.catSystem.catnipLevel;
+    g.boostPercent = sim.prestigeShop.boostPercent;
+    g.spacePresses = sim.intro.spacePresses;
+    g.announcementStep = sim.intro.announcementStep;
+    g.prestigeUnlocked = sim.game.prestigeUnlocked;
+    g.prestigeHintShown = sim.game.prestigeHintShown;
+    g.hasGoldenSword = sim.prestigeShop.hasGoldenSword;
+    g.inShop = sim.prestigeShop.inShop;
+    g.inIntro = sim.intro.inIntro;
+    g.unlockAvailable = sim.intro.unlockAvailable;
+    g.buildingsUnlocked = sim.intro.buildingsUnlocked;
+    g.clearedAfterFirstSpace = sim.intro.clearedAfterFirstSpace;
+
+    for (size_t i = 0; i < items.size(); ++i) {
+        const ShopItem* item = sim.shopItems[i].get();
+        SavedItem s{};
+        s.multiplier = 1.0f;
+        if (const Building* b = dynamic_cast<const Building*>(item)) {
+            s.count = b->getCount();
+            s.multiplier = b->getMultiplier();
+        } else if (const Upgrade* u = dynamic_cast<const Upgrade*>(item)) {
+            s.purchased = u->isPurchased();
+        }
+        s.wasVisible = item->hasBeenVisible();
+        items[i] = s;
+    }
+
+    static const unsigned char padding[alignof(SavedGame)] = {};
+    size_t pad = header.recordSize - sizeof(g) - items.size() * sizeof(SavedItem);
+    checksum = fnv1a(checksum, &g, sizeof(g));
+    checksum = fnv1a(checksum, items.data(), items.size() * sizeof(SavedItem));
+    checksum = fnv1a(checksum, padding, pad);
+    if (std::fwrite(&g, sizeof(g), 1, file) != 1 ||
+        std::fwrite(items.data(), sizeof(SavedItem), items.size(), file) != items.size() ||
+        std::fwrite(padding, 1, pad, file) != pad) {
+        failed = true;
+        return false;
+    }
+    added++;
+    return true;
+}
+
+bool SaveWriter::commit() {
+    if (!file) return false;
+    header.checksum = checksum;
+    bool ok = !failed && added == header.games &&
+              std::fseek(file, 0, SEEK_SET) == 0 &&
+              std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+              syncFile(file);
+    ok = std::fclose(file) == 0 && ok;
+    file = nullptr;
+    if (ok) ok = replaceFile(tempPath, path);
+    if (!ok) std::remove(tempPath.c_str());
+    return ok;
+}
+
+bool saveGame(const std::string& path, const Simulation& sim) {
+    SaveWriter writer;
+    return writer.begin(path, 1, sim.catalog()) && writer.add(sim) && writer.commit();
+}
+
+// ========================
+// LOADING
+// ========================
+SaveFile::~SaveFile() {
+    close();
+}
+
+bool SaveFile::open(const std::string& path) {
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart >= (LONGLONG)sizeof(SaveHeader)) {
+        size = (size_t)fileSize.QuadPart;
+        HANDLE map = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (map) {
+            data = static_cast<const unsigned char*>(MapViewOfFile(map, FILE_MAP_READ, 0, 0, 0));
+            if (data) {
+                mapping = map;
+                mapped = true;
+            } else {
+                CloseHandle(map);
+            }
+        }
+    }
+    CloseHandle(file); // The mapping keeps the file open
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size >= (off_t)sizeof(SaveHeader)) {
+        size = (size_t)info.st_size;
+        void* p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+            data = static_cast<const unsigned char*>(p);
+            mapped = true;
+        }
+    }
+    ::close(fd); // The mapping keeps the file open
+#endif
+    if (!data) {
+        size = 0;
+        return false;
+    }
+    return check();
+}
+
+bool SaveFile::openBytes(const void* bytes, size_t n) {
+    close();
+    if (!bytes || n < sizeof(SaveHeader)) return false;
+    data = static_cast<const unsigned char*>(bytes);
+    size = n;
+    return check();
+}
+
+bool SaveFile::check() {
+    const SaveHeader* h = header();
+    bool valid = std::memcmp(h->magic, SAVE_MAGIC, sizeof(SAVE_MAGIC)) == 0 &&
+                 h->version == SAVE_VERSION &&
+                 h->headerSize == sizeof(SaveHeader) &&
+                 h->recordSize == recordSize(h->itemsPerGame) &&
+                 h->games <= (size - sizeof(SaveHeader)) / h->recordSize &&
+                 size == sizeof(SaveHeader) + h->games * h->recordSize &&
+                 fnv1a(FNV_OFFSET, data + sizeof(SaveHeader), size - sizeof(SaveHeader)) == h->checksum;
+    if (!valid) close();
+    return valid;
+}
+
+void SaveFile::close() {
+    if (mapped) {
+#ifdef _WIN32
+        UnmapViewOfFile(data);
+        CloseHandle(static_cast<HANDLE>(mapping));
+#else
+        munmap(const_cast<unsigned char*>(data), size);
+#endif
+    }
+    data = nullptr;
+    size = 0;
+    mapping = nullptr;
+    mapped = false;
+}
+
+bool SaveFile::restore(uint64_t index, Simulation& sim) const {
+    const SaveHeader* h = header();
+    if (!h || index >= h->games || sim.shopItems.size() != h->itemsPerGame ||
+        sim.catalog().layoutHash() != h->catalogHash) {
+        return false;
+    }
+    const unsigned char* record = data + sizeof(SaveHeader) + index * h->recordSize;
+    const SavedGame& g = *reinterpret_cast<const SavedGame*>(record);
+    const SavedItem* items = reinterpret_cast<const SavedItem*>(record + sizeof(SavedGame));
+
+    // Boost% first: a fresh shop picks it up, then the rows are set outright
+    sim.prestigeShop.boostPercent = g.boostPercent;
+    sim.prestigeShop.hasGoldenSword = g.hasGoldenSword;
+    sim.prestigeShop.inShop = g.inShop;
+    initializeShopItems(sim.shopItems, sim.buildings, sim.prestigeShop, sim.catalog());
+    for (uint32_t i = 0; i < h->itemsPerGame; ++i) {
+        ShopItem* item = sim.shopItems[i].get();
+        if (Building* b = dynamic_cast<Building*>(item)) {
+            sim.buildings.setRow(b->getRow(), items[i].count, items[i].multiplier);
+        } else if (Upgrade* u = dynamic_cast<Upgrade*>(item)) {
+            u->setPurchased(items[i].purchased != 0);
+        }
+        if (items[i].wasVisible) item->setWasVisible();
+    }
+
+    GameState& game = sim.game;
+    game.totalPies = fromSaved(g.totalPies);
+    game.piesPerSecond = fromSaved(g.piesPerSecond);
+    game.piesBakedThisRun = fromSaved(g.piesBakedThisRun);
+    game.prestigeStars = g.prestigeStars;
+    game.pieCarry = g.pieCarry;
+    game.untickedSeconds = g.untickedSeconds;
+    game.goalAchieved = false;
+    game.prestigeUnlocked = g.prestigeUnlocked != 0;
+    game.prestigeHintShown = g.prestigeHintShown != 0;
+    sim.catSystem.milkPurchased = g.milkPurchased;
+    sim.catSystem.catnipLevel = g.catnipLevel;
+
+    IntroState& intro = sim.intro;
+    intro = IntroState();
+    intro.inIntro = g.inIntro != 0;
+    intro.spacePresses = g.spacePresses;
+    intro.announcementStep = g.announcementStep;
+    intro.unlockAvailable = g.unlockAvailable != 0;
+    intro.buildingsUnlocked = g.buildingsUnlocked != 0;
+    intro.clearedAfterFirstSpace = g.clearedAfterFirstSpace != 0;
+    sim.messages.clear();
+    game.ratSystem.setState(g.totalRats, fromSaved(g.ratsEating), g.ratsEatingSingle, g.eatenCarry);
+    sim.reindex();
+    return true;
+}
+
+bool loadGame(const std::string& path, Simulation& sim, int64_t* savedAt) {
+    SaveFile file;
+    if (!file.open(path) || file.games() != 1 || !file.restore(0, sim)) return false;
+    if (savedAt) *savedAt = file.savedAt();
+    return true;
+}
+
+} // End of namespace piegame
@@ -0,0 +1,165 @@
+#pragma once
+
+#include "Simulation.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace piegame {
+
+// ========================
+// SAVE FILE LAYOUT
+// ========================
+// A save file is a header followed by fixed-size game records, and each
+// record is a SavedGame followed by one SavedItem per shop item, padded to a
+// multiple of alignof(SavedGame). Everything is plain fixed-width fields in
+// the machine's byte order, so loading maps the file and reads the records
+// in place; nothing is parsed.
+//
+// One game is a player's save; many games of the same catalog are a
+// checkpoint of a batch job (see BatchEnv::store / load).
+//
+// Bump SAVE_VERSION whenever any of these structs change.
+const uint32_t SAVE_VERSION = 5;
+
+struct SaveHeader {
+    char magic[4];         // "PIES"
+    uint32_t version;      // SAVE_VERSION
+    uint32_t headerSize;   // sizeof(SaveHeader)...
+    uint32_t recordSize;   // ...and bytes per game, as the writer compiled them
+    uint64_t games;        // Number of game records
+    uint32_t itemsPerGame; // Shop items per record
+    uint32_t checksum;     // FNV-1a of all the records
+    int64_t savedAt;       // Wall-clock time of writing, in Unix seconds
+    uint32_t catalogHash;  // ShopCatalog::layoutHash() of the games' shop
+    uint32_t unused;
+};
+
+struct SavedNumber {       // A BigNumber's raw fields
+    int64_t bits;
+    int32_t exponent;
+    int32_t unused;
+};
+
+struct SavedGame {
+    SavedNumber totalPies;
+    SavedNumber piesPerSecond;
+    SavedNumber piesBakedThisRun;
+    SavedNumber ratsEating;
+    double untickedSeconds;
+    float prestigeStars;
+    float ratsEatingSingle;
+    int32_t pieCarry;
+    int32_t eatenCarry;
+    int32_t milkPurchased;
+    int32_t catnipLevel;
+    int32_t boostPercent;
+    int32_t spacePresses;
+    int32_t announcementStep;
+    int32_t totalRats;
+    uint8_t retired;       // Was goalAchieved: a save is always a game still in play
+    uint8_t prestigeUnlocked;
+    uint8_t prestigeHintShown;
+    uint8_t hasGoldenSword;
+    uint8_t inShop;
+    uint8_t inIntro;
+    uint8_t unlockAvailable;
+    uint8_t buildingsUnlocked;
+    uint8_t clearedAfterFirstSpace;
+    uint8_t unused[7];
+};
+
+struct SavedItem {
+    int32_t count;         // Buildings owned (0 for upgrades)
+    float multiplier;      // Building multiplier (1 for upgrades)
+    uint8_t purchased;     // Upgrade bought
+    uint8_t wasVisible;    // Listed in the shop
+    uint8_t unused[2];
+};
+
+static_assert(std::is_trivially_copyable<SaveHeader>::value && sizeof(SaveHeader) == 48, "SaveHeader layout");
+static_assert(sizeof(SavedGame) == 128, "SavedGame layout");
+static_assert(sizeof(SavedItem) == 12, "SavedItem layout");
+static_assert(sizeof(SaveHeader) % alignof(SavedGame) == 0, "Records start aligned");
+
+// ========================
+// SAVING
+// ========================
+// Writes games one at a time into a temporary file next to `path`; commit()
+// flushes it to disk and renames it over `path`, so a crash at any point
+// leaves either the old file or the new one, never half of each.
+class SaveWriter {
+public:
+    SaveWriter() = default;
+    ~SaveWriter(); // Drops the temporary file if commit() was never reached
+    SaveWriter(const SaveWriter&) = delete;
+    SaveWriter& operator=(const SaveWriter&) = delete;
+
+    // Starts a file of `games` records of games that buy from `catalog`
+    bool begin(const std::string& path, uint64_t games, const ShopCatalog& catalog);
+
+    // Appends a game; it must buy from a catalog of the same layout
+    bool add(const Simulation& sim);
+
+    // Finishes the file and puts it in place; false if anything failed
+    bool commit();
+
+private:
+    std::string path;
+    std::string tempPath;
+    std::FILE* file = nullptr;
+    SaveHeader header{};
+    uint64_t added = 0;
+    uint32_t checksum = 0;
+    bool failed = false;
+    std::vector<SavedItem> items; // One record's items, reused
+};
+
+// Saves one game to path (atomically)
+bool saveGame(const std::string& path, const Simulation& sim);
+
+// ========================
+// LOADING
+// ========================
+// A save file mapped into memory. open() checks the header, the size and
+// the checksum; after that restore() copies a record straight into a game.
+class SaveFile {
+public:
+    SaveFile() = default;
+    ~SaveFile();
+    SaveFile(const SaveFile&) = delete;
+    SaveFile& operator=(const SaveFile&) = delete;
+
+    // False if the file is missing, from another version, or damaged
+    bool open(const std::string& path);
+    // The same checks on a save already in memory, which is used in place
+    // and must outlive this object (a journal's starting save, for one)
+    bool openBytes(const void* bytes, size_t n);
+    void close();
+
+    uint64_t games() const { return header() ? header()->games : 0; }
+    int64_t savedAt() const { return header() ? header()->savedAt : 0; } // Unix seconds
+
+    // Puts record `index` into sim, whatever state it was in. False (and
+    // sim untouched) if sim's catalog is not laid out as the saved one was
+    // (other items, or the same number of items in another order).
+    bool restore(uint64_t index, Simulation& sim) const;
+
+private:
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+    void* mapping = nullptr; // Windows mapping handle
+    bool mapped = false;     // data is a mapping of ours, not openBytes() memory
+
+    const SaveHeader* header() const { return reinterpret_cast<const SaveHeader*>(data); }
+    bool check();
+};
+
+// Loads a one-game save into sim; false (and sim untouched) if there is
+// none. savedAt, if given, gets the time the save was written.
+bool loadGame(const std::string& path, Simulation& sim, int64_t* savedAt = nullptr);
+
+} // End of namespace piegame
@@ -0,0 +1,150 @@
+#include "SessionHost.h"
+
+#include "PrestigeCatalog.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace piegame {
+
+bool actionForKey(const Simulation& sim, int key, Action& action) {
+    bool digit = key >= '1' && key <= '9';
+    if (sim.inPrestigeShop()) {
+        if (key == '0') action = { ActionType::LeavePrestigeShop };
+        else if (key >= '1' && key <= '0' + PrestigeCatalog::size) action = { ActionType::BuyPrestigeUpgrade, key - '1' };
+        else return false;
+        return true;
+    }
+    if (key == ' ') action = { ActionType::BakePie };
+    else if (digit && key - '1' < (int)sim.shopItems.size()) action = { ActionType::BuyItem, key - '1' };
+    else if (key == 'U' && sim.intro.inIntro) action = { ActionType::UnlockBuildings };
+    else if (key == 'R' && !sim.intro.inIntro) action = { ActionType::Prestige };
+    else return false;
+    return true;
+}
+
+// ========================
+// SESSION HOST
+// ========================
+SessionHost::SessionHost(unsigned threads) {
+    unsigned count = threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned i = 0; i < count; ++i) shards.push_back(std::make_unique<Shard>());
+    for (auto& shard : shards) {
+        Shard* s = shard.get();
+        s->worker = std::thread([this, s] { work(*s); });
+    }
+}
+
+SessionHost::~SessionHost() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    start.notify_all();
+    for (auto& shard : shards) shard->worker.join();
+}
+
+int SessionHost::open() {
+    int id = nextId++;
+    Shard& shard = *shards[(size_t)id % shards.size()];
+    auto session = std::make_unique<Session>();
+    session->id = id;
+    session->slot = shard.sessions.size();
+    byId[id] = session.get();
+    shard.sessions.push_back(std::move(session));
+    return id;
+}
+
+void SessionHost::close(int id) {
+    auto found = byId.find(id);
+    if (found == byId.end()) return;
+    Shard& shard = *shards[(size_t)id % shards.size()];
+    size_t slot = found->second->slot;
+    byId.erase(found);
+
+    // Swap the last session into the hole so the shard stays packed
+    std::swap(shard.sessions[slot], shard.sessions.back());
+    shard.sessions[slot]->slot = slot;
+    shard.sessions.pop_back();
+}
+
+bool SessionHost::send(int id, int key) {
+    auto found = byId.find(id);
+    if (found == byId.end()) return false;
+    found->second->keys += (char)key;
+    return true;
+}
+
+const SessionView* SessionHost::view(int id) const {
+    auto found = byId.find(id);
+    return found == byId.end() ? nullptr : &found->second->view;
+}
+
+void SessionHost::tick(float deltaTime) {
+    std::unique_lock<std::mutex> guard(lock);
+    frameTime = deltaTime;
+    done = 0;
+    ++generation;
+    start.notify_all();
+    finished.wait(guard, [&] { return done == shards.size(); });
+}
+
+double SessionHost::lastTickSeconds() const {
+    double slowest = 0.0;
+    for (const auto& shard : shards) slowest = std::max(slowest, shard->tickSeconds);
+    return slowest;
+}
+
+void SessionHost::work(Shard& shard) {
+    unsigned long long seen = 0;
+    for (;;) {
+        float deltaTime;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            start.wait(guard, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+            deltaTime = frameTime;
+        }
+
+        auto began = std::chrono::steady_clock::now();
+        for (auto& session : shard.sessions) tickSession(*session, deltaTime);
+        shard.tickSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - began).count();
+
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            ++done;
+        }
+        finished.notify_one();
+    }
+}
+
+// One frame of one game, as the console loop plays it: keys first, then time
+void SessionHost::tickSession(Session& session, float deltaTime) {
+    Simulation& sim = session.sim;
+    for (char key : session.keys) {
+        if (sim.goalReached()) {
+            // The celebration's play-again prompt
+            if (key == 'Y') sim.startRun();
+            continue;
+        }
+        Action action;
+        if (actionForKey(sim, key, action)) sim.apply(action);
+    }
+    session.keys.clear();
+
+    // The celebration holds the game still until the player answers
+    if (!sim.goalReached() && !sim.inPrestigeShop()) sim.step(deltaTime);
+
+    SessionView& view = session.view;
+    view.screen = sim.goalReached() ? SessionScreen::Won
+                : sim.inPrestigeShop() ? SessionScreen::PrestigeShop
+                : sim.intro.inIntro ? SessionScreen::Intro
+                : SessionScreen::Game;
+    view.pies = sim.game.totalPies.toDouble();
+    view.piesPerSecond = sim.game.piesPerSecond.toDouble();
+    view.rats = sim.game.ratSystem.getTotalRats();
+    view.prestigeStars = sim.game.prestigeStars;
+}
+
+} // End of namespace piegame
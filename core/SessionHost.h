@@ -0,0 +1,103 @@
+#pragma once
+
+#include "Simulation.h"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace piegame {
+
+// ========================
+// SESSION KEYS
+// ========================
+// The action a game key stands for on the session's current screen, as the
+// console front end reads it: SPACE bakes, digits buy, U unlocks, R
+// prestiges, and in the prestige shop digits buy upgrades and 0 leaves.
+// The debug keys are not played here. False if the key does nothing there.
+bool actionForKey(const Simulation& sim, int key, Action& action);
+
+// ========================
+// SESSION HOST
+// ========================
+// Many isolated games in one process. Sessions are dealt round-robin to a
+// fixed set of shards; each shard has one worker thread, and tick() has
+// every worker step its whole shard once and waits for all of them.
+//
+// open(), close(), send() and view() belong to one I/O thread and are only
+// called between ticks, so sessions need no locks: while a tick runs, each
+// session is touched by its own shard's worker alone.
+enum class SessionScreen { Intro, Game, PrestigeShop, Won };
+
+// What a client sees of its game after each tick
+struct SessionView {
+    SessionScreen screen = SessionScreen::Intro;
+    double pies = 0.0;
+    double piesPerSecond = 0.0;
+    int rats = 0;
+    float prestigeStars = 0.0f;
+};
+
+class SessionHost {
+public:
+    explicit SessionHost(unsigned threads = 0); // 0: one per core
+    ~SessionHost();
+    SessionHost(const SessionHost&) = delete;
+    SessionHost& operator=(const SessionHost&) = delete;
+
+    // Starts a new game at the beginning of the intro; returns its id
+    int open();
+    void close(int id);
+
+    // Queues a game key for the session's next tick. False for unknown ids.
+    bool send(int id, int key);
+
+    // The session's view as of the last tick. Null for unknown ids.
+    const SessionView* view(int id) const;
+
+    // Applies every queued key and steps every session by deltaTime
+    void tick(float deltaTime);
+
+    size_t sessions() const { return byId.size(); }
+    unsigned threads() const { return (unsigned)shards.size(); }
+
+    // Wall seconds the slowest shard took in the last tick
+    double lastTickSeconds() const;
+
+private:
+    struct Session {
+        int id;
+        size_t slot;       // Index in its shard's list
+        Simulation sim;
+        std::string keys;  // Queued by send(), applied on the next tick
+        SessionView view;
+    };
+
+    struct Shard {
+        std::vector<std::unique_ptr<Session>> sessions;
+        double tickSeconds = 0.0;
+        std::thread worker;
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::unordered_map<int, Session*> byId;
+    int nextId = 1;
+
+    // Tick hand-off: tick() bumps generation, workers step and count in
+    std::mutex lock;
+    std::condition_variable start;
+    std::condition_variable finished;
+    unsigned long long generation = 0;
+    unsigned done = 0;
+    float frameTime = 0.0f;
+    bool stopping = false;
+
+    void work(Shard& shard);
+    static void tickSession(Session& session, float deltaTime);
+};
+
+} // End of namespace piegame
@@ -0,0 +1,198 @@
+#include "ShopCatalog.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace piegame {
+
+namespace {
+
+// data/shop.txt, for builds that run without the data directory
+const char* STANDARD_CATALOG = R"(
+building | Grandma | 10  | 1
+building | Bakery  | 50  | 5
+building | Factory | 200 | 20
+
+upgrade | Grandma's Secret Recipe | 500   | 5   | Grandma
+upgrade | Bakery Automation       | 2000  | 3   | Bakery
+upgrade | Turbo Conveyor          | 10000 | 2   | Factory
+
+upgrade | Grandma's Robot Arms    | 5000  | 3   | Grandma | Grandma's Secret Recipe
+upgrade | Bakery Franchise        | 15000 | 2.5 | Bakery  | Bakery Automation
+upgrade | Factory AI Overlord     | 50000 | 2   | Factory | Turbo Conveyor
+)";
+
+std::string trimmed(const std::string& text) {
+    size_t begin = text.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) return std::string();
+    size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+std::vector<std::string> fields(const std::string& line) {
+    std::vector<std::string> out;
+    std::stringstream in(line);
+    std::string field;
+    while (std::getline(in, field, '|')) out.push_back(trimmed(field));
+    return out;
+}
+
+// A whole positive (or, with allowZero, non-negative) int
+bool parseCount(const std::string& text, int& value, bool allowZero) {
+    char* end;
+    long parsed = strtol(text.c_str(), &end, 10);
+    if (text.empty() || *end || parsed > 2000000000L || parsed < (allowZero ? 0 : 1)) return false;
+    value = (int)parsed;
+    return true;
+}
+
+} // namespace
+
+const ShopCatalog& ShopCatalog::standard() {
+    static const ShopCatalog catalog = [] {
+        ShopCatalog c;
+        std::string error;
+        c.parse(STANDARD_CATALOG, error, "standard catalog");
+        return c;
+    }();
+    return catalog;
+}
+
+bool ShopCatalog::parse(const std::string& text, std::string& error, const std::string& source) {
+    std::vector<CatalogEntry> parsed;
+    std::unordered_map<std::string, int> names;
+    std::vector<std::string> targets; // By name until every building is known
+    std::vector<int> lines;
+
+    std::stringstream in(text);
+    std::string line;
+    int lineNumber = 0;
+    auto fail = [&](int at, const std::string& why) {
+        error = source + " line " + std::to_string(at) + ": " + why;
+        return false;
+    };
+
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        line = trimmed(line);
+        if (line.empty() || line[0] == '#') continue;
+        std::vector<std::string> f = fields(line);
+
+        CatalogEntry entry;
+        entry.name = f.size() > 1 ? f[1] : std::string();
+        if (entry.name.empty()) return fail(lineNumber, "item without a name");
+        if (names.count(entry.name)) return fail(lineNumber, "'" + entry.name + "' is listed twice");
+
+        std::string target;
+        if (f[0] == "building") {
+            entry.kind = ShopKind::Building;
+            if (f.size() != 4) return fail(lineNumber, "a building takes name | base cost | pies per second");
+            if (!parseCount(f[2], entry.cost, false)) return fail(lineNumber, "bad cost '" + f[2] + "'");
+            if (!parseCount(f[3], entry.piesPerSecond, true)) return fail(lineNumber, "bad pies per second '" + f[3] + "'");
+        } else if (f[0] == "upgrade") {
+            entry.kind = ShopKind::Upgrade;
+            if (f.size() != 5 && f.size() != 6) {
+                return fail(lineNumber, "an upgrade takes name | cost | multiplier | building | prerequisite (optional)");
+            }
+            if (!parseCount(f[2], entry.cost, false)) return fail(lineNumber, "bad cost '" + f[2] + "'");
+            char* end;
+            entry.multiplier = strtof(f[3].c_str(), &end);
+            if (f[3].empty() || *end || !(entry.multiplier > 0.0f)) return fail(lineNumber, "bad multiplier '" + f[3] + "'");
+            target = f[4];
+            if (f.size() == 6 && !f[5].empty()) {
+                // Listed above this one, so prerequisites never form a loop
+                auto found = names.find(f[5]);
+                if (found == names.end() || parsed[found->second].kind != ShopKind::Upgrade) {
+                    return fail(lineNumber, "prerequisite '" + f[5] + "' is not an upgrade listed above");
+                }
+                entry.prerequisite = found->second;
+            }
+        } else {
+            return fail(lineNumber, "unknown kind '" + f[0] + "' (building or upgrade)");
+        }
+
+        names[entry.name] = (int)parsed.size();
+        parsed.push_back(entry);
+        targets.push_back(target);
+        lines.push_back(lineNumber);
+    }
+
+    if (parsed.empty()) return fail(lineNumber, "no buildings or upgrades");
+
+    // Upgrades may boost buildings listed further down
+    for (size_t i = 0; i < parsed.size(); ++i) {
+        if (parsed[i].kind != ShopKind::Upgrade) continue;
+        auto found = names.find(targets[i]);
+        if (found == names.end() || parsed[found->second].kind != ShopKind::Building) {
+            return fail(lines[i], "'" + targets[i] + "' is not a building");
+        }
+        parsed[i].target = found->second;
+    }
+
+    entries.swap(parsed);
+    byName.swap(names);
+
+    // Dependents, grouped by prerequisite
+    dependentStart.assign(entries.size() + 1, 0);
+    for (const CatalogEntry& e : entries) {
+        if (e.prerequisite >= 0) dependentStart[e.prerequisite + 1]++;
+    }
+    for (size_t i = 0; i < entries.size(); ++i) dependentStart[i + 1] += dependentStart[i];
+    dependents.assign(dependentStart.back(), 0);
+    std::vector<int> filled(dependentStart.begin(), dependentStart.end() - 1);
+    for (int i = 0; i < size(); ++i) {
+        if (entries[i].prerequisite >= 0) dependents[filled[entries[i].prerequisite]++] = i;
+    }
+
+    // Layout hash; the name's terminating 0 keeps "AB","C" apart from "A","BC"
+    layout = 2166136261u;
+    auto mix = [&](const void* bytes, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            layout ^= static_cast<const unsigned char*>(bytes)[i];
+            layout *= 16777619u;
+        }
+    };
+    for (const CatalogEntry& e : entries) {
+        int32_t fields[3] = { (int32_t)e.kind, e.target, e.prerequisite };
+        mix(fields, sizeof(fields));
+        mix(e.name.c_str(), e.name.size() + 1);
+    }
+    return true;
+}
+
+bool ShopCatalog::load(const std::string& path, std::string& error) {
+    error.clear();
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    std::stringstream text;
+    text << in.rdbuf();
+    return parse(text.str(), error, path);
+}
+
+int ShopCatalog::find(const std::string& name) const {
+    auto found = byName.find(name);
+    return found == byName.end() ? -1 : found->second;
+}
+
+ShopCatalog ShopCatalog::scaled(const CatalogScale& scale) const {
+    auto price = [](int cost, double factor) {
+        return (int)std::min(std::max(std::llround(cost * factor), 1LL), (long long)INT_MAX);
+    };
+    ShopCatalog copy = *this;
+    for (CatalogEntry& e : copy.entries) {
+        if (e.kind == ShopKind::Building) {
+            e.cost = price(e.cost, scale.buildingCost);
+            e.piesPerSecond = (int)std::min(std::llround(e.piesPerSecond * scale.buildingOutput), (long long)INT_MAX);
+        } else {
+            e.cost = price(e.cost, scale.upgradeCost);
+            e.multiplier = std::max(1.0f + (float)((e.multiplier - 1.0f) * scale.upgradeBonus), 0.01f);
+        }
+    }
+    return copy;
+}
+
+} // End of namespace piegame
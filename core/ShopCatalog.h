@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace piegame {
+
+// ========================
+// SHOP CATALOG
+// ========================
+// The buildings and upgrades a run can buy, as content. Each line of a
+// catalog file is one item, in shop order, with fields split by '|':
+//
+//   building | name | base cost | pies per second
+//   upgrade  | name | cost | multiplier | building | prerequisite (optional)
+//
+// Blank lines and lines starting with '#' are skipped. Names are unique;
+// an upgrade names the building it boosts and the upgrade needed first,
+// which has to be listed above it. Both are resolved to catalog indices
+// when the file is loaded. data/shop.txt is the standard catalog.
+enum class ShopKind { Building, Upgrade };
+
+struct CatalogEntry {
+    ShopKind kind;
+    std::string name;
+    int cost;                 // Building: price of the first one; upgrade: its price
+    int piesPerSecond = 0;    // Building: output of one
+    float multiplier = 1.0f;  // Upgrade: factor on its building's output
+    int target = -1;          // Upgrade: catalog index of that building
+    int prerequisite = -1;    // Upgrade: catalog index of the upgrade bought first
+};
+
+// Factors for ShopCatalog::scaled(), all 1 for the catalog as it is
+struct CatalogScale {
+    double buildingCost = 1.0;
+    double buildingOutput = 1.0;
+    double upgradeCost = 1.0;
+    double upgradeBonus = 1.0; // On (multiplier - 1): 2 turns x1.5 into x2
+};
+
+class ShopCatalog {
+public:
+    // The game's own 3 buildings and 6 upgrades (data/shop.txt, built in)
+    static const ShopCatalog& standard();
+
+    // Replaces the catalog with the items in `text`. On a bad line returns
+    // false, keeps the catalog as it was and says why in `error`.
+    bool parse(const std::string& text, std::string& error, const std::string& source = "catalog");
+
+    // parse() on a file's contents. False with `error` left empty if the
+    // file cannot be read.
+    bool load(const std::string& path, std::string& error);
+
+    int size() const { return (int)entries.size(); }
+    const CatalogEntry& operator[](int index) const { return entries[index]; }
+
+    // Catalog index of the item called `name`, or -1
+    int find(const std::string& name) const;
+
+    // The same items with scaled prices, outputs and upgrade bonuses (for
+    // balance tools). Prices round to the nearest pie, at least 1.
+    ShopCatalog scaled(const CatalogScale& scale) const;
+
+    // FNV-1a of what each slot is (kind, name, upgrade target and
+    // prerequisite) but not of prices or outputs: saves check it to know
+    // their items line up with this catalog's
+    uint32_t layoutHash() const { return layout; }
+
+    // Upgrades whose prerequisite is `index`, as a range of catalog indices
+    const int* dependentsBegin(int index) const { return dependents.data() + dependentStart[index]; }
+    const int* dependentsEnd(int index) const { return dependents.data() + dependentStart[index + 1]; }
+
+private:
+    std::vector<CatalogEntry> entries;
+    std::unordered_map<std::string, int> byName;
+    std::vector<int> dependentStart; // size() + 1 offsets into dependents
+    std::vector<int> dependents;
+    uint32_t layout = 0;
+};
+
+} // End of namespace piegame
@@ -0,0 +1,338 @@
+#include "Simulation.h"
+#include "PrestigeCatalog.h"
+
+#include <algorithm>
+#include <climits>
+
+namespace piegame {
+
+namespace {
+
+// Intro messages and the SPACE presses that bring them up; the last one
+// also offers the [U] unlock
+struct IntroMilestone {
+    int presses;
+    const char* text;
+};
+const IntroMilestone INTRO_MILESTONES[] = {
+    { 10, "You've boke 10 already!" },
+    { 20, "Isn't this so much fun?" },
+    { 30, "Only 9,999,980 more to go!" },
+    { 40, "Don't worry, your spacebar can handle a million presses... probably." },
+    { 50, "Fine, buy some grandmas to help you." },
+};
+const int INTRO_MILESTONE_COUNT = sizeof(INTRO_MILESTONES) / sizeof(INTRO_MILESTONES[0]);
+
+// Events on pies baked this run
+enum RunEvent { PRESTIGE_UNLOCK, PRESTIGE_HINT };
+
+} // namespace
+
+Simulation::Simulation(const ShopCatalog& catalog) : shopCatalog(&catalog) {
+    startRun();
+}
+
+// ========================
+// RUN SETUP
+// ========================
+// Resets the game state for a new run (after prestige or win)
+void Simulation::resetGameState() {
+    game.totalPies = 0;
+    game.piesPerSecond = 0;
+    game.pieCarry = 0;
+    game.untickedSeconds = 0.0;
+    game.piesBakedThisRun = 0;
+    game.prestigeHintShown = false; // Reset the prestige hint for each new run
+    game.goalAchieved = false;
+}
+
+void Simulation::startRun() {
+    resetGameState();
+    initializeShopItems(shopItems, buildings, prestigeShop, *shopCatalog);
+
+    intro.inIntro = true;
+    game.totalPies = 1;
+    intro.spacePresses = 0;
+    intro.announcementStep = 0;
+    messages.clear();
+    intro.unlockAvailable = false;
+    intro.buildingsUnlocked = false;
+    intro.clearedAfterFirstSpace = false;
+    reindex();
+}
+
+void Simulation::skipIntro() {
+    intro.inIntro = false;
+    intro.clearedAfterFirstSpace = true;
+    intro.unlockAvailable = true;
+    intro.buildingsUnlocked = true;
+    messages.clear();
+}
+
+float Simulation::prestigeStarsForReset() const {
+    return sqrt((float)game.piesBakedThisRun.toDouble() / 1000.0f);
+}
+
+float Simulation::secondsUntilChange() const {
+    double next = NOTHING_CHANGES;
+    if (intro.inIntro) {
+        // The intro only bakes on SPACE; its messages are the one timer
+        if (messages.active()) next = messages.secondsUntilChange();
+        return (float)next;
+    }
+
+    if (messages.active()) next = std::min(next, (double)messages.secondsUntilChange());
+    if (game.untickedSeconds >= TICK_SECONDS - TICK_SLACK) return 0.0f;
+
+    // Rates and carries count in 1/TICKS_PER_SECOND pies: the first tick
+    // whose share brings `units` of them in
+    double toTick = TICK_SECONDS - game.untickedSeconds;
+    auto tickBringing = [&](double units, double perTick) {
+        return toTick + std::max(std::ceil(units / perTick) - 1.0, 0.0) * TICK_SECONDS;
+    };
+    double pps = game.piesPerSecond.toDouble();
+    if (pps > 0.0) {
+        next = std::min(next, tickBringing(TICKS_PER_SECOND - game.pieCarry, pps));
+        double toRats = (double)game.ratSystem.getThreshold() - game.totalPies.toDouble();
+        if (toRats > 0.0) next = std::min(next, tickBringing(toRats * TICKS_PER_SECOND - game.pieCarry, pps));
+    }
+    double eating = game.ratSystem.getRatsEating().toDouble();
+    if (eating > 0.0) {
+        next = std::min(next, tickBringing(TICKS_PER_SECOND - game.ratSystem.getEatenCarry(), eating));
+    }
+    return (float)std::max(next, 0.0);
+}
+
+// ========================
+// ACTIONS
+// ========================
+bool Simulation::apply(const Action& action) {
+    if (prestigeShop.inShop) {
+        // Only the shop screen takes input while it is open
+        if (action.type == ActionType::BuyPrestigeUpgrade) return buyPrestigeUpgrade(action.index);
+        if (action.type == ActionType::LeavePrestigeShop) {
+            prestigeShop.inShop = false;
+            return true;
+        }
+        return false;
+    }
+
+    switch (action.type) {
+    case ActionType::BakePie:
+        if (intro.inIntro) {
+            if (!intro.clearedAfterFirstSpace) {
+                intro.clearedAfterFirstSpace = true;
+                game.totalPies = 1;
+                intro.spacePresses = 1;
+            } else {
+                game.totalPies++;
+                intro.spacePresses++;
+            }
+        } else {
+            game.totalPies += 1 + (1 * prestigeShop.boostPercent / 100);
+            game.piesBakedThisRun += 1 + (1 * prestigeShop.boostPercent / 100);
+        }
+        return true;
+
+    case ActionType::BuyItem:
+        return buyItem(action.index, action.count);
+
+    case ActionType::UnlockBuildings:
+        if (!intro.inIntro || !intro.unlockAvailable || game.totalPies < UNLOCK_BUILDINGS_COST) return false;
+        game.totalPies -= UNLOCK_BUILDINGS_COST;
+        intro.buildingsUnlocked = true;
+        intro.inIntro = false;
+        return true;
+
+    case ActionType::Prestige:
+        if (intro.inIntro || game.piesBakedThisRun < PRESTIGE_MIN_PIES) return false;
+        game.prestigeStars += prestigeStarsForReset();
+        resetGameState();
+        initializeShopItems(shopItems, buildings, prestigeShop, *shopCatalog);
+        reindex();
+        prestigeShop.inShop = true;
+        return true;
+
+    case ActionType::DebugSetMillion:
+        if (intro.inIntro) return false;
+        game.totalPies = 1000000;
+        game.piesBakedThisRun = 1000000;
+        return true;
+
+    case ActionType::DebugAddPies:
+        if (intro.inIntro) return false;
+        game.totalPies += 50000;
+        game.piesBakedThisRun += 50000;
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+bool Simulation::buyItem(int index, int count) {
+    if (index < 0 || index >= (int)shopItems.size()) return false;
+    ShopItem& item = *shopItems[index];
+    // Upgrades only come one at a time
+    if (count != 1 && (*shopCatalog)[index].kind == ShopKind::Building) {
+        return buyBuildings(static_cast<Building&>(item), count);
+    }
+    if (!item.canPurchase(game.totalPies)) return false;
+
+    game.totalPies -= item.getCost();
+    item.purchase();
+    messages.show(item.getName() + " purchased!", MESSAGE_DURATION, MessagePriority::Low);
+
+    // A bought upgrade leaves the list and lets the ones after it show up
+    if ((*shopCatalog)[index].kind == ShopKind::Upgrade) {
+        auto at = std::lower_bound(listed.begin(), listed.end(), index);
+        if (at != listed.end() && *at == index) listed.erase(at);
+        for (const int* d = shopCatalog->dependentsBegin(index); d != shopCatalog->dependentsEnd(index); ++d) {
+            watchForVisibility(*d);
+        }
+    }
+    // The intro recomputes pies per second every frame anyway
+    if (!intro.inIntro) game.piesPerSecond = buildings.getTotalPiesPerSecond();
+    return true;
+}
+
+// Prices the whole batch in closed form, so buying 1,000 costs what buying 1 does
+bool Simulation::buyBuildings(Building& building, int count) {
+    if (count == BUY_MAX) count = building.getAffordable(game.totalPies);
+    if (count <= 0 || count > INT_MAX - building.getCount()) return false;
+    BigNumber cost = building.getCost(count);
+    if (game.totalPies < cost) return false;
+
+    game.totalPies -= cost;
+    building.purchase(count);
+    messages.show(building.getName() + (count > 1 ? " x" + std::to_string(count) : "") + " purchased!",
+                  MESSAGE_DURATION, MessagePriority::Low);
+    if (!intro.inIntro) game.piesPerSecond = buildings.getTotalPiesPerSecond();
+    return true;
+}
+
+bool Simulation::buyPrestigeUpgrade(int index) {
+    if (!prestigeUpgradeVisible(index, prestigeShop, catSystem)) return false; // Also false for bad slots
+    int cost = prestigeUpgradeCost(index, prestigeShop, catSystem);
+    if (game.prestigeStars < cost) return false;
+    game.prestigeStars -= cost;
+    applyPrestigeUpgrade(index, prestigeShop, catSystem);
+    buildings.setBoostPercent(prestigeShop.boostPercent);
+    return true;
+}
+
+// ========================
+// TIME STEP
+// ========================
+void Simulation::step(float deltaTime) {
+    if (prestigeShop.inShop) return; // The world is paused while shopping
+    if (intro.inIntro) stepIntro(deltaTime);
+    else stepGame(deltaTime);
+}
+
+void Simulation::stepIntro(float deltaTime) {
+    // Update pies per second
+    game.piesPerSecond = buildings.getTotalPiesPerSecond();
+
+    // Announcements at milestones
+    pressThresholds.fire(intro.spacePresses, [&](int milestone) {
+        messages.show(INTRO_MILESTONES[milestone].text, INTRO_ANNOUNCEMENT_DURATION, MessagePriority::High);
+        intro.announcementStep = milestone + 1;
+        if (milestone == INTRO_MILESTONE_COUNT - 1) intro.unlockAvailable = true;
+    });
+
+    messages.update(deltaTime);
+}
+
+void Simulation::stepGame(float deltaTime) {
+    {
+        FrameProfiler::Scope timed(profiler, FramePhase::Messages);
+        messages.update(deltaTime);
+    }
+
+    game.untickedSeconds += deltaTime;
+    for (int ticks = 0; ticks < MAX_TICKS_PER_STEP && game.untickedSeconds >= TICK_SECONDS - TICK_SLACK; ++ticks) {
+        game.untickedSeconds -= TICK_SECONDS;
+        tickGame();
+    }
+}
+
+// One economy tick: everything that depends on the pie count, so it happens
+// at the same tick whatever the frame rate
+void Simulation::tickGame() {
+    // Apply pies per second
+    {
+        FrameProfiler::Scope timed(profiler, FramePhase::Pies);
+        BigNumber baked = tickShare(game.piesPerSecond, game.pieCarry);
+        game.totalPies += baked;
+        game.piesBakedThisRun += baked;
+    }
+
+    // Rats eat pies (cats eat rats first)
+    {
+        FrameProfiler::Scope timed(profiler, FramePhase::Rats);
+        game.ratSystem.tick(game.totalPies, game.piesPerSecond, catSystem);
+    }
+
+    // Prestige unlocks for good once reached; the hint comes once a run
+    runThresholds.fire(game.piesBakedThisRun, [&](int event) {
+        if (event == PRESTIGE_UNLOCK) {
+            game.prestigeUnlocked = true;
+        } else if (!game.prestigeHintShown) {
+            messages.show("Tip: If progress slows down, try PRESTIGE (press R) for permanent upgrades!");
+            game.prestigeHintShown = true;
+        }
+    });
+
+    // Shop items stay listed once they have been visible
+    FrameProfiler::Scope timed(profiler, FramePhase::Shop);
+    updateVisibility();
+}
+
+// ========================
+// THRESHOLDS
+// ========================
+void Simulation::reindex() {
+    pressThresholds.clear();
+    for (int m = intro.announcementStep; m < INTRO_MILESTONE_COUNT; ++m) {
+        pressThresholds.watch(INTRO_MILESTONES[m].presses, m);
+    }
+    runThresholds.clear();
+    if (!game.prestigeUnlocked) runThresholds.watch(PRESTIGE_MIN_PIES, PRESTIGE_UNLOCK);
+    if (!game.prestigeHintShown) runThresholds.watch(PRESTIGE_HINT_PIES, PRESTIGE_HINT);
+
+    // Shop visibility
+    shopResets++;
+    shopThresholds.clear();
+    listed.clear();
+    for (int slot = 0; slot < (int)shopItems.size(); ++slot) {
+        const ShopItem& item = *shopItems[slot];
+        bool upgrade = (*shopCatalog)[slot].kind == ShopKind::Upgrade;
+        bool bought = upgrade && static_cast<const Upgrade&>(item).isPurchased();
+        if (item.hasBeenVisible()) {
+            if (!bought) listed.push_back(slot);
+            continue;
+        }
+        const int prerequisite = (*shopCatalog)[slot].prerequisite;
+        bool ready = prerequisite < 0 || static_cast<const Upgrade&>(*shopItems[prerequisite]).isPurchased();
+        if (!bought && ready) watchForVisibility(slot);
+    }
+}
+
+// The pie count where the item's isVisible() turns true
+void Simulation::watchForVisibility(int slot) {
+    const CatalogEntry& entry = (*shopCatalog)[slot];
+    shopThresholds.watch(entry.kind == ShopKind::Building ? entry.cost : entry.cost / 2, slot);
+}
+
+void Simulation::updateVisibility() {
+    shopThresholds.fire(game.totalPies, [&](int slot) {
+        // Bought before it ever showed: never listed
+        ShopItem& item = *shopItems[slot];
+        if (!item.isVisible(game.totalPies)) return;
+        item.setWasVisible();
+        listed.insert(std::upper_bound(listed.begin(), listed.end(), slot), slot);
+    });
+}
+
+} // End of namespace piegame
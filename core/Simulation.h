@@ -0,0 +1,133 @@
+#pragma once
+
+#include "FrameProfiler.h"
+#include "GameCore.h"
+#include "MessageBoard.h"
+#include "ThresholdIndex.h"
+
+namespace piegame {
+
+// ========================
+// PLAYER ACTIONS
+// ========================
+// Everything a player can do, independent of which key produced it
+enum class ActionType {
+    BakePie,            // [SPACE]
+    BuyItem,            // [1]..[9] in the intro or main game (index = shop slot)
+    UnlockBuildings,    // [U] at the end of the intro
+    Prestige,           // [R] once enough pies were baked this run
+    BuyPrestigeUpgrade, // [1]..[4] inside the prestige shop (index = upgrade slot)
+    LeavePrestigeShop,  // [0] inside the prestige shop
+    DebugSetMillion,    // [X] secret test button
+    DebugAddPies        // [Z] secret test button
+};
+
+const int BUY_MAX = -1; // Action::count: as many buildings as the pies pay for
+
+struct Action {
+    ActionType type;
+    int index = 0; // Shop or upgrade slot for the Buy* actions
+    int count = 1; // BuyItem on a building: how many, all or none (or BUY_MAX)
+};
+
+// ========================
+// SIMULATION
+// ========================
+// One complete, headless game: state, cats, prestige shop, shop items,
+// messages and intro. The console front end only reads it and feeds
+// it actions; batch tools can run as many of these side by side as they like.
+class Simulation {
+public:
+    GameState game;            // Pies, stars and rats
+    CatSystem catSystem;       // Milk and catnip
+    PrestigeShop prestigeShop; // Permanent upgrades
+    ShopList shopItems;        // Buildings and upgrades for this run
+    BuildingTable buildings;   // Building counts and outputs behind shopItems
+    MessageBoard messages;     // Messages for the player, intro and main game
+    IntroState intro;          // Tutorial progress
+
+    FrameProfiler* profiler = nullptr; // Times step()'s phases when set (front end only)
+
+    // Runs of this game buy from `catalog`, which has to outlive it
+    explicit Simulation(const ShopCatalog& catalog = ShopCatalog::standard());
+
+    // The building pointers refer back into this object
+    Simulation(const Simulation&) = delete;
+    Simulation& operator=(const Simulation&) = delete;
+
+    // Starts a fresh run at the beginning of the intro (new game or "play again")
+    void startRun();
+
+    // Skips the tutorial, as if [U] had just been pressed (for batch tools)
+    void skipIntro();
+
+    // Applies one player action. Returns false if it had no effect
+    // (not affordable, wrong screen, ...).
+    bool apply(const Action& action);
+
+    // Advances the world by deltaTime seconds. Pies and rats move in whole
+    // economy ticks (see TICKS_PER_SECOND), so any mix of frame lengths that
+    // adds up to the same time ends in the same state. Time short of a tick
+    // waits for the next call, as does a backlog past MAX_TICKS_PER_STEP.
+    void step(float deltaTime);
+
+    // Has this run reached the 1,000,000 pie goal?
+    bool goalReached() const { return game.totalPies >= GOAL_PIES; }
+
+    // Is the player currently in the prestige shop?
+    bool inPrestigeShop() const { return prestigeShop.inShop; }
+
+    // Prestige stars a reset would give right now
+    float prestigeStarsForReset() const;
+
+    // Shop slots the main screen lists, in shop order: buildings once they
+    // have been visible, upgrades once visible until bought
+    const std::vector<int>& listedItems() const { return listed; }
+
+    const ShopCatalog& catalog() const { return *shopCatalog; }
+
+    // Rebuilds the threshold indexes (shop visibility, intro milestones,
+    // prestige unlock and hint) from the items' and the game's flags, for
+    // code that restored them by hand (see SaveFile::restore)
+    void reindex();
+
+    // Bumped whenever shopItems is rebuilt (new run, prestige, restore), so
+    // code that keeps its own view of the shop knows to start over
+    unsigned shopGeneration() const { return shopResets; }
+
+    // Seconds of step() before anything on screen changes by itself: the
+    // tick that brings the next whole pie, rats finishing a pie or rats
+    // arriving, a message running out (0 while ticks are backed up).
+    // NOTHING_CHANGES if none of these is coming. Front ends sleep this
+    // long when there is no input.
+    float secondsUntilChange() const;
+    static constexpr float NOTHING_CHANGES = 3600.0f;
+
+private:
+    const ShopCatalog* shopCatalog;
+
+    // Everything step() waits for, one index per watched quantity, so a
+    // frame costs one comparison each whatever the number of milestones
+    // and catalog entries:
+    //   - items not yet visible, by the pie count that shows them (event:
+    //     shop slot). Upgrades join when their prerequisite is bought.
+    //   - intro milestones by SPACE presses (event: milestone)
+    //   - the prestige unlock and hint by pies baked this run
+    ThresholdIndex<int> shopThresholds;
+    ThresholdIndex<int> pressThresholds;
+    ThresholdIndex<int> runThresholds;
+    std::vector<int> listed;
+    unsigned shopResets = 0;
+
+    void watchForVisibility(int slot);
+    void updateVisibility();
+    void resetGameState();
+    void stepIntro(float deltaTime);
+    void stepGame(float deltaTime);
+    void tickGame();
+    bool buyItem(int index, int count);
+    bool buyBuildings(Building& building, int count);
+    bool buyPrestigeUpgrade(int index);
+};
+
+} // End of namespace piegame
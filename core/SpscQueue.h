@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace piegame {
+
+// ========================
+// SINGLE-PRODUCER QUEUE
+// ========================
+// A fixed ring buffer for exactly one thread pushing and one thread popping,
+// with no locks: each side owns one index and only reads the other's.
+// Capacity must be a power of two; push() fails rather than overwrite when
+// the ring is full.
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    // Producer side
+    bool push(const T& value) {
+        size_t tail = tailIndex.load(std::memory_order_relaxed);
+        if (tail - headIndex.load(std::memory_order_acquire) == Capacity) return false;
+        slots[tail & (Capacity - 1)] = value;
+        tailIndex.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side
+    bool pop(T& value) {
+        size_t head = headIndex.load(std::memory_order_relaxed);
+        if (head == tailIndex.load(std::memory_order_acquire)) return false;
+        value = slots[head & (Capacity - 1)];
+        headIndex.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Either side (a snapshot; the other side may change it right after)
+    bool empty() const {
+        return headIndex.load(std::memory_order_acquire) == tailIndex.load(std::memory_order_acquire);
+    }
+
+private:
+    // Each index on its own cache line, so the two threads do not share one
+    alignas(64) std::atomic<size_t> headIndex{ 0 };
+    alignas(64) std::atomic<size_t> tailIndex{ 0 };
+    alignas(64) T slots[Capacity];
+};
+
+} // End of namespace piegame
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace piegame {
+
+// ========================
+// THRESHOLD INDEX
+// ========================
+// Events that happen once a watched quantity (the pie count, SPACE presses)
+// first reaches their threshold, in a min-heap on the threshold. fire()
+// hands the ones a value has reached to a callback, lowest threshold first
+// (ties in event order), and forgets them. A value that reaches none costs
+// one comparison, however many events are waiting.
+//
+// An event fires once: to watch it again (a new run), watch() it again.
+template <typename Threshold>
+class ThresholdIndex {
+public:
+    void watch(const Threshold& threshold, int event) {
+        heap.push_back({ threshold, event });
+        std::push_heap(heap.begin(), heap.end(), std::greater<Entry>());
+    }
+
+    // Calls fire(event) for every waiting event whose threshold value has reached
+    template <typename Value, typename Fire>
+    void fire(const Value& value, Fire callback) {
+        while (!heap.empty() && value >= heap.front().first) {
+            int event = heap.front().second;
+            std::pop_heap(heap.begin(), heap.end(), std::greater<Entry>());
+            heap.pop_back();
+            callback(event);
+        }
+    }
+
+    bool empty() const { return heap.empty(); }
+    size_t size() const { return heap.size(); }
+    const Threshold& next() const { return heap.front().first; } // Lowest waiting threshold
+    void clear() { heap.clear(); }
+
+private:
+    typedef std::pair<Threshold, int> Entry; // Threshold, event
+    std::vector<Entry> heap;
+};
+
+} // End of namespace piegame
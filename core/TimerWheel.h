@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace piegame {
+
+// ========================
+// TIMER WHEEL
+// ========================
+// Hierarchical timing wheel: timers due within the next 256 ticks sit in
+// the slot of their tick, later ones in coarser wheels of 64 slots that
+// cascade down as the time comes near. Scheduling is O(1), and so is
+// advancing one tick (the cascades add up to O(1) per timer), so expiring
+// timers costs the same with 3 of them running or 30,000.
+//
+// A timer is an id plus the tick it is due at. There is no cancel: a
+// caller that reschedules an id checks the tick an expiry comes with
+// against the one it still wants, and ignores the stale ones.
+class TimerWheel {
+public:
+    typedef uint64_t Tick;
+
+    explicit TimerWheel(double secondsPerTick) : resolution(secondsPerTick) {}
+
+    // Schedules `id` for `delay` seconds from now, rounded up to whole ticks
+    // (at least one). Returns the tick it is due at.
+    Tick schedule(uint32_t id, double delay) {
+        double ticks = std::ceil(delay / resolution + carry - 1e-9);
+        Tick due = current + (ticks > 1.0 ? (Tick)ticks : 1);
+        place({ id, due });
+        live++;
+        return due;
+    }
+
+    // Moves the clock dt seconds on and calls expire(id, due) for every
+    // timer it passes, in the order they come due. expire may schedule new
+    // timers. With nothing scheduled, the clock jumps straight to the end.
+    template <typename Expire>
+    void advance(double dt, Expire expire) {
+        carry += dt / resolution;
+        Tick steps = (Tick)carry;
+        carry -= (double)steps;
+        while (steps > 0) {
+            if (live == 0) {
+                current += steps;
+                return;
+            }
+            ++current;
+            --steps;
+            if ((current & NEAR_MASK) == 0) {
+                Tick index = (current >> NEAR_BITS) & FAR_MASK;
+                if (index == 0) cascade(2, (current >> (NEAR_BITS + FAR_BITS)) & FAR_MASK);
+                cascade(1, index);
+            }
+
+            // expire() may schedule into the wheel: fire from outside it
+            std::vector<Entry>& slot = slots[current & NEAR_MASK];
+            if (slot.empty()) continue;
+            firing.swap(slot);
+            for (const Entry& e : firing) {
+                live--;
+                expire(e.id, e.due);
+            }
+            firing.clear();
+        }
+    }
+
+    // Seconds from now until tick `due` starts (0 if it has)
+    double secondsUntil(Tick due) const {
+        double ticks = (double)(due - current) - carry;
+        return due > current && ticks > 0.0 ? ticks * resolution : 0.0;
+    }
+
+    Tick now() const { return current; }
+    size_t scheduled() const { return live; }
+
+    void clear() {
+        for (auto& slot : slots) slot.clear();
+        live = 0;
+    }
+
+private:
+    struct Entry {
+        uint32_t id;
+        Tick due;
+    };
+
+    static const int NEAR_BITS = 8; // Wheel 0: one slot per tick
+    static const int FAR_BITS = 6;  // Wheels 1 and 2: one slot per 2^8 and 2^14 ticks
+    static const Tick NEAR_MASK = (1u << NEAR_BITS) - 1;
+    static const Tick FAR_MASK = (1u << FAR_BITS) - 1;
+    static const int NEAR_SLOTS = 1 << NEAR_BITS;
+    static const int FAR_SLOTS = 1 << FAR_BITS;
+    static const Tick SPAN = Tick(1) << (NEAR_BITS + 2 * FAR_BITS); // Ticks the wheels cover
+
+    double resolution;
+    double carry = 0.0; // Part of a tick already advanced
+    Tick current = 0;
+    size_t live = 0;
+    // Wheel 0, then wheel 1, then wheel 2, in one array
+    std::vector<Entry> slots[NEAR_SLOTS + 2 * FAR_SLOTS];
+    std::vector<Entry> firing;    // Slot being expired
+    std::vector<Entry> cascading; // Slot being spread over the wheels below
+
+    void place(const Entry& e) {
+        Tick ahead = e.due - current;
+        if (ahead < (Tick(1) << NEAR_BITS)) {
+            slots[e.due & NEAR_MASK].push_back(e);
+        } else if (ahead < (Tick(1) << (NEAR_BITS + FAR_BITS))) {
+            slots[NEAR_SLOTS + ((e.due >> NEAR_BITS) & FAR_MASK)].push_back(e);
+        } else {
+            // Past the last wheel: park in its furthest slot, placed again
+            // (by its real due tick) when that slot cascades
+            Tick at = ahead < SPAN ? e.due : current + SPAN - 1;
+            slots[NEAR_SLOTS + FAR_SLOTS + ((at >> (NEAR_BITS + FAR_BITS)) & FAR_MASK)].push_back(e);
+        }
+    }
+
+    // Spreads one slot of wheel 1 or 2 over the wheels below (a parked
+    // timer goes back to wheel 2, one slot short of this one)
+    void cascade(int wheel, Tick index) {
+        std::vector<Entry>& slot = slots[NEAR_SLOTS + (wheel - 1) * FAR_SLOTS + index];
+        if (slot.empty()) return;
+        cascading.swap(slot);
+        for (const Entry& e : cascading) place(e);
+        cascading.clear();
+    }
+};
+
+} // End of namespace piegame
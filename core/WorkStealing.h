@@ -0,0 +1,96 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace piegame {
+
+// ========================
+// WORK-STEALING POOL
+// ========================
+// Runs job(i) for every i in [0, count) on all cores. Each worker owns a
+// range of indices and takes them one at a time from the front; a worker
+// that runs dry steals the back half of the fullest other range. Games vary
+// wildly in length (a stalled run plays for days of game time, a lucky one
+// for minutes), so a static split would leave most cores idle at the end.
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(unsigned threads = 0)
+        : threadCount(threads ? threads : std::max(1u, std::thread::hardware_concurrency())) {}
+
+    unsigned size() const { return threadCount; }
+
+    // job(index, worker) is called once per index; returns when all are done
+    void run(size_t count, const std::function<void(size_t, unsigned)>& job) {
+        std::vector<Range> ranges(threadCount);
+        for (unsigned w = 0; w < threadCount; ++w) {
+            ranges[w].begin = count * w / threadCount;
+            ranges[w].end = count * (w + 1) / threadCount;
+        }
+
+        auto worker = [&](unsigned self) {
+            size_t index;
+            while (takeOwn(ranges[self], index) || steal(ranges, self, index)) {
+                job(index, self);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (unsigned w = 1; w < threadCount; ++w) threads.emplace_back(worker, w);
+        worker(0); // The calling thread works too
+        for (auto& t : threads) t.join();
+    }
+
+private:
+    struct Range {
+        std::mutex lock;
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    unsigned threadCount;
+
+    static bool takeOwn(Range& range, size_t& index) {
+        std::lock_guard<std::mutex> guard(range.lock);
+        if (range.begin >= range.end) return false;
+        index = range.begin++;
+        return true;
+    }
+
+    // Moves the back half of the fullest other range into ours and takes its first index
+    static bool steal(std::vector<Range>& ranges, unsigned self, size_t& index) {
+        while (true) {
+            unsigned victim = self;
+            size_t most = 0;
+            for (unsigned w = 0; w < ranges.size(); ++w) {
+                if (w == self) continue;
+                std::lock_guard<std::mutex> guard(ranges[w].lock);
+                size_t left = ranges[w].end - ranges[w].begin;
+                if (left > most) { most = left; victim = w; }
+            }
+            if (victim == self) return false; // Everything is taken
+
+            size_t first, last;
+            {
+                std::lock_guard<std::mutex> guard(ranges[victim].lock);
+                size_t left = ranges[victim].end - ranges[victim].begin;
+                if (left == 0) continue; // Someone beat us to it; look again
+                size_t half = (left + 1) / 2;
+                last = ranges[victim].end;
+                first = last - half;
+                ranges[victim].end = first;
+            }
+            std::lock_guard<std::mutex> guard(ranges[self].lock);
+            index = first;
+            ranges[self].begin = first + 1;
+            ranges[self].end = last;
+            return true;
+        }
+    }
+};
+
+} // End of namespace piegame
@@ -0,0 +1,350 @@
+// Tries the game's balance constants over a grid or a Latin hypercube: for
+// each point it plays a field of scripted players to the goal on all cores
+// and records how the run went, one row per point, in a column file (or
+// CSV). Every point meets the same players (clicking speed, patience), so
+// differences between rows come from the constants, not from the draw.
+//
+// Parameters (name, low, high; the game as shipped in brackets):
+//   rat_threshold 20000..100000 [50000]   rat_eat_rate 0.5..2 [1]
+//   rat_max 1000..999999 [999999]         rat_growth 0.9..1.2 [1.01]
+//   rat_growth_boost 0.3..1.1 [0.7]       milk_base 5..20 [10]
+//   milk_step 1..4 [2]                    catnip_base 1..5 [1]
+//   catnip_step 1..3 [1]                  building_cost 0.5..2 [1]
+//   building_output 0.5..2 [1]            upgrade_cost 0.5..2 [1]
+//   upgrade_bonus 0.5..2 [1] (scales each upgrade's multiplier - 1)
+// Only the parameters in --vary move; the rest keep the shipped value.
+//
+// Column file: "PIECOLS1", a uint32 column count and a uint64 row count,
+// then per column a uint8 type (0: float64, 1: int32), a uint8 name length
+// and the name, then every column's values back to back, in the machine's
+// byte order. A reader loads one column without touching the others.
+// Build: g++ -std=c++17 -O2 -pthread tools/BalanceSweep.cpp core/GameCore.cpp core/ShopCatalog.cpp core/BigNumber.cpp core/Simulation.cpp core/MessageBoard.cpp core/FastForward.cpp core/AutoPlayer.cpp -o balancesweep
+// Usage: balancesweep [--grid levels | --lhs points] [--vary name,name,...] [--games perPoint]
+//                     [--seed n] [--threads n] [--out sweep.cols] [--csv sweep.csv]
+//        balancesweep --show sweep.cols   (prints a column file as CSV)
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../core/AutoPlayer.h"
+#include "../core/WorkStealing.h"
+
+using namespace piegame;
+
+// ========================
+// PARAMETERS
+// ========================
+struct Parameter {
+    const char* name;
+    double low, high;
+    double shipped;
+    bool integer;
+};
+
+const Parameter PARAMETERS[] = {
+    { "rat_threshold",    20000, 100000, 50000,  true },
+    { "rat_eat_rate",     0.5,   2.0,    1.0,    false },
+    { "rat_max",          1000,  999999, 999999, true },
+    { "rat_growth",       0.9,   1.2,    1.01,   false },
+    { "rat_growth_boost", 0.3,   1.1,    0.7,    false },
+    { "milk_base",        5,     20,     10,     true },
+    { "milk_step",        1,     4,      2,      true },
+    { "catnip_base",      1,     5,      1,      true },
+    { "catnip_step",      1,     3,      1,      true },
+    { "building_cost",    0.5,   2.0,    1.0,    false },
+    { "building_output",  0.5,   2.0,    1.0,    false },
+    { "upgrade_cost",     0.5,   2.0,    1.0,    false },
+    { "upgrade_bonus",    0.5,   2.0,    1.0,    false },
+};
+const int PARAMETER_COUNT = sizeof(PARAMETERS) / sizeof(PARAMETERS[0]);
+
+typedef std::vector<double> Point; // One value per PARAMETERS entry
+
+// A value of parameter p at `fraction` of its range
+double valueAt(int p, double fraction) {
+    const Parameter& param = PARAMETERS[p];
+    double value = param.low + (param.high - param.low) * fraction;
+    return param.integer ? std::round(value) : value;
+}
+
+// Every combination of `levels` evenly spaced values of the varied parameters
+std::vector<Point> gridPoints(const std::vector<int>& varied, int levels) {
+    Point shipped;
+    for (const Parameter& param : PARAMETERS) shipped.push_back(param.shipped);
+    std::vector<Point> points(1, shipped);
+    for (int p : varied) {
+        std::vector<Point> next;
+        for (const Point& point : points) {
+            for (int level = 0; level < levels; ++level) {
+                Point q = point;
+                q[p] = valueAt(p, levels > 1 ? level / (levels - 1.0) : 0.5);
+                next.push_back(q);
+            }
+        }
+        points.swap(next);
+    }
+    return points;
+}
+
+// `count` points where each varied parameter visits each of `count` equal
+// slices of its range exactly once, the slices paired up at random
+std::vector<Point> latinHypercube(const std::vector<int>& varied, int count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> within(0.0, 1.0);
+    std::vector<Point> points(count);
+    for (Point& point : points) {
+        for (const Parameter& param : PARAMETERS) point.push_back(param.shipped);
+    }
+    std::vector<int> slices(count);
+    for (int p : varied) {
+        for (int i = 0; i < count; ++i) slices[i] = i;
+        std::shuffle(slices.begin(), slices.end(), rng);
+        for (int i = 0; i < count; ++i) points[i][p] = valueAt(p, (slices[i] + within(rng)) / count);
+    }
+    return points;
+}
+
+// ========================
+// PLAYING A POINT
+// ========================
+struct Balance {
+    ShopCatalog catalog;
+    RatRules rats;
+    PrestigePrices prices;
+};
+
+Balance makeBalance(const Point& v) {
+    Balance b;
+    b.rats.threshold = (int)v[0];
+    b.rats.eatRate = (float)v[1];
+    b.rats.maxRats = (int)v[2];
+    b.rats.growth = v[3];
+    b.rats.growthBoost = v[4];
+    b.prices.milkBase = (int)v[5];
+    b.prices.milkStep = (int)v[6];
+    b.prices.catnipBase = (int)v[7];
+    b.prices.catnipStep = (int)v[8];
+    CatalogScale scale;
+    scale.buildingCost = v[9];
+    scale.buildingOutput = v[10];
+    scale.upgradeCost = v[11];
+    scale.upgradeBonus = v[12];
+    b.catalog = ShopCatalog::standard().scaled(scale);
+    return b;
+}
+
+// Player `game` of every point: the same one each time
+PlayerProfile makeProfile(size_t game) {
+    std::mt19937 rng((unsigned)game * 2654435761u + 12345u);
+    PlayerProfile profile;
+    profile.clicksPerSecond = std::uniform_real_distribution<double>(3.0, 9.0)(rng);
+    profile.slowSeconds = std::uniform_real_distribution<double>(600.0, 3600.0)(rng);
+    return profile;
+}
+
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return std::numeric_limits<double>::quiet_NaN();
+    size_t i = (size_t)std::min<double>(sorted.size() - 1, p * (sorted.size() - 1) + 0.5);
+    return sorted[i];
+}
+
+// ========================
+// COLUMN FILE
+// ========================
+struct Column {
+    std::string name;
+    bool integer;
+    std::vector<double> values; // Written as int32 when `integer`
+};
+
+const char COLUMN_MAGIC[8] = { 'P', 'I', 'E', 'C', 'O', 'L', 'S', '1' };
+
+bool writeColumns(const std::string& path, const std::vector<Column>& columns) {
+    std::ofstream out(path, std::ios::binary);
+    uint32_t count = (uint32_t)columns.size();
+    uint64_t rows = columns.empty() ? 0 : columns[0].values.size();
+    out.write(COLUMN_MAGIC, sizeof COLUMN_MAGIC);
+    out.write((const char*)&count, sizeof count);
+    out.write((const char*)&rows, sizeof rows);
+    for (const Column& c : columns) {
+        uint8_t type = c.integer ? 1 : 0;
+        uint8_t length = (uint8_t)std::min<size_t>(c.name.size(), 255);
+        out.write((const char*)&type, 1);
+        out.write((const char*)&length, 1);
+        out.write(c.name.data(), length);
+    }
+    for (const Column& c : columns) {
+        if (c.integer) {
+            std::vector<int32_t> ints(c.values.begin(), c.values.end());
+            out.write((const char*)ints.data(), ints.size() * sizeof(int32_t));
+        } else {
+            out.write((const char*)c.values.data(), c.values.size() * sizeof(double));
+        }
+    }
+    return (bool)out;
+}
+
+bool readColumns(const std::string& path, std::vector<Column>& columns) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[8];
+    uint32_t count = 0;
+    uint64_t rows = 0;
+    in.read(magic, sizeof magic);
+    in.read((char*)&count, sizeof count);
+    in.read((char*)&rows, sizeof rows);
+    if (!in || std::memcmp(magic, COLUMN_MAGIC, sizeof magic) != 0) return false;
+    columns.assign(count, Column());
+    for (Column& c : columns) {
+        uint8_t type = 0, length = 0;
+        in.read((char*)&type, 1);
+        in.read((char*)&length, 1);
+        c.name.resize(length);
+        in.read(&c.name[0], length);
+        c.integer = type == 1;
+    }
+    for (Column& c : columns) {
+        if (c.integer) {
+            std::vector<int32_t> ints(rows);
+            in.read((char*)ints.data(), rows * sizeof(int32_t));
+            c.values.assign(ints.begin(), ints.end());
+        } else {
+            c.values.resize(rows);
+            in.read((char*)c.values.data(), rows * sizeof(double));
+        }
+    }
+    return (bool)in;
+}
+
+void writeCsv(std::ostream& out, const std::vector<Column>& columns) {
+    for (size_t c = 0; c < columns.size(); ++c) out << (c ? "," : "") << columns[c].name;
+    out << "\n" << std::setprecision(10);
+    size_t rows = columns.empty() ? 0 : columns[0].values.size();
+    for (size_t r = 0; r < rows; ++r) {
+        for (size_t c = 0; c < columns.size(); ++c) {
+            double v = columns[c].values[r];
+            out << (c ? "," : "");
+            if (columns[c].integer) out << (long long)v;
+            else if (!std::isnan(v)) out << v; // Empty field: no value (e.g. no game finished)
+        }
+        out << "\n";
+    }
+}
+
+// ========================
+// MAIN
+// ========================
+int main(int argc, char** argv) {
+    int gridLevels = 0, lhsPoints = 0, games = 64;
+    unsigned seed = 1, threads = 0;
+    std::string vary = "rat_threshold,rat_eat_rate,building_cost,building_output";
+    std::string outPath = "sweep.cols", csvPath, showPath;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string flag = argv[i];
+        if (flag == "--grid") gridLevels = atoi(argv[i + 1]);
+        else if (flag == "--lhs") lhsPoints = atoi(argv[i + 1]);
+        else if (flag == "--vary") vary = argv[i + 1];
+        else if (flag == "--games") games = atoi(argv[i + 1]);
+        else if (flag == "--seed") seed = (unsigned)atoi(argv[i + 1]);
+        else if (flag == "--threads") threads = (unsigned)atoi(argv[i + 1]);
+        else if (flag == "--out") outPath = argv[i + 1];
+        else if (flag == "--csv") csvPath = argv[i + 1];
+        else if (flag == "--show") showPath = argv[i + 1];
+        else {
+            std::cerr << "Unknown option " << flag << "\n";
+            return 2;
+        }
+    }
+
+    if (!showPath.empty()) {
+        std::vector<Column> columns;
+        if (!readColumns(showPath, columns)) {
+            std::cerr << showPath << ": not a column file\n";
+            return 1;
+        }
+        writeCsv(std::cout, columns);
+        return 0;
+    }
+
+    std::vector<int> varied;
+    std::stringstream names(vary);
+    for (std::string name; std::getline(names, name, ',');) {
+        int p = 0;
+        while (p < PARAMETER_COUNT && name != PARAMETERS[p].name) ++p;
+        if (p == PARAMETER_COUNT) {
+            std::cerr << "Unknown parameter " << name << "\n";
+            return 2;
+        }
+        varied.push_back(p);
+    }
+    if (gridLevels <= 0 && lhsPoints <= 0) gridLevels = 3;
+    std::vector<Point> points = lhsPoints > 0 ? latinHypercube(varied, lhsPoints, seed) : gridPoints(varied, gridLevels);
+
+    // Simulations keep a pointer to their catalog: build them all up front
+    std::vector<Balance> balances;
+    balances.reserve(points.size());
+    for (const Point& point : points) balances.push_back(makeBalance(point));
+
+    WorkStealingPool pool(threads);
+    size_t jobs = points.size() * (size_t)games;
+    std::vector<GameResult> results(jobs);
+    auto start = std::chrono::steady_clock::now();
+    pool.run(jobs, [&](size_t index, unsigned) {
+        const Balance& balance = balances[index / games];
+        Simulation sim(balance.catalog);
+        sim.game.ratSystem.setRules(balance.rats);
+        sim.prestigeShop.prices = balance.prices;
+        results[index] = playGame(sim, makeProfile(index % games));
+    });
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // One row per point: its parameters, then how its games went
+    std::vector<Column> columns;
+    columns.push_back({ "point", true, {} });
+    for (const Parameter& param : PARAMETERS) columns.push_back({ param.name, param.integer, {} });
+    const char* outcomes[] = { "finished", "p10_seconds", "median_seconds", "p90_seconds", "prestiges", "purchases" };
+    for (const char* name : outcomes) columns.push_back({ name, false, {} });
+
+    for (size_t pt = 0; pt < points.size(); ++pt) {
+        std::vector<double> times;
+        double prestiges = 0.0, purchases = 0.0;
+        for (int g = 0; g < games; ++g) {
+            const GameResult& r = results[pt * games + g];
+            if (r.reachedGoal) times.push_back(r.seconds);
+            prestiges += r.prestiges;
+            purchases += r.purchases;
+        }
+        std::sort(times.begin(), times.end());
+        const double row[] = { (double)times.size() / games, percentile(times, 0.1), percentile(times, 0.5),
+                               percentile(times, 0.9), prestiges / games, purchases / games };
+
+        size_t c = 0;
+        columns[c++].values.push_back((double)pt);
+        for (double v : points[pt]) columns[c++].values.push_back(v);
+        for (double v : row) columns[c++].values.push_back(v);
+    }
+
+    bool written = writeColumns(outPath, columns);
+    if (!csvPath.empty()) {
+        std::ofstream csv(csvPath);
+        writeCsv(csv, columns);
+        written = written && (bool)csv;
+    }
+
+    std::cout << points.size() << " points x " << games << " games = " << jobs << " games on " << pool.size()
+              << " threads in " << std::fixed << std::setprecision(1) << wall << " s ("
+              << (long long)(jobs / wall) << " games/s)\n"
+              << (written ? "wrote " : "could not write ") << outPath << (csvPath.empty() ? "" : " and " + csvPath)
+              << "\n";
+    return written ? 0 : 1;
+}
@@ -0,0 +1,100 @@
+// Plans the fastest purchase order to a pie target with the branch-and-bound
+// solver, then plays the plan frame by frame to check the predicted time,
+// next to a greedy best-pies/sec-per-pie player for comparison.
+// Build: g++ -std=c++17 -O2 tools/BuyPlanner.cpp core/GameCore.cpp core/ShopCatalog.cpp core/BigNumber.cpp core/Simulation.cpp core/MessageBoard.cpp core/FastForward.cpp core/AutoPlayer.cpp core/SaveFile.cpp core/PurchaseSolver.cpp -o buyplanner
+// Usage: buyplanner [targetPies] [clicksPerSecond] [beamWidth (0: exact)] [save]
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <cmath>
+#include <string>
+
+#include "../core/AutoPlayer.h"
+#include "../core/PurchaseSolver.h"
+#include "../core/SaveFile.h"
+
+using namespace piegame;
+
+const double FRAME = TICK_SECONDS;
+const double GIVE_UP_SECONDS = 7 * 86400.0;
+
+// The starting game: a save, or a fresh run just past the intro
+static bool setUp(Simulation& sim, const char* savePath) {
+    if (savePath) return loadGame(savePath, sim);
+    sim.skipIntro();
+    return true;
+}
+
+// Plays frames, clicking at clicksPerSecond and asking `pick` what to buy
+// whenever it is affordable, until the target. Returns the seconds it took.
+template <typename Pick>
+static double play(Simulation& sim, double target, double clicksPerSecond, Pick pick) {
+    double clock = 0.0, clickCredit = 0.0;
+    while (sim.game.totalPies.toDouble() + sim.game.pendingPies() < target && clock < GIVE_UP_SECONDS) {
+        int slot;
+        while ((slot = pick(sim)) >= 0 && sim.apply({ ActionType::BuyItem, slot })) {}
+        clickCredit += clicksPerSecond * FRAME;
+        for (; clickCredit >= 1.0; clickCredit -= 1.0) sim.apply({ ActionType::BakePie });
+        sim.step((float)FRAME);
+        clock += FRAME;
+    }
+    return clock;
+}
+
+int main(int argc, char** argv) {
+    double target = argc > 1 ? atof(argv[1]) : 100000.0;
+    double clicks = argc > 2 ? atof(argv[2]) : 6.0;
+    SolverOptions options;
+    options.clicksPerSecond = clicks;
+    if (argc > 3) options.beamWidth = (size_t)atoll(argv[3]);
+    const char* savePath = argc > 4 ? argv[4] : nullptr;
+
+    Simulation start;
+    if (!setUp(start, savePath)) {
+        std::cerr << "Cannot load " << savePath << "\n";
+        return 1;
+    }
+
+    auto began = std::chrono::steady_clock::now();
+    PurchasePlan plan = solvePurchases(start, target, options);
+    double solveMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - began).count();
+
+    std::cout << "Target " << (long long)target << " pies, clicking " << clicks << "/s, from "
+              << (savePath ? savePath : "a fresh run") << "\n"
+              << "Solver: " << plan.nodes << " nodes in " << solveMs << " ms"
+              << (plan.optimal ? " (optimal)" : " (beam or budget limited: best found)") << "\n\n";
+    if (std::isinf(plan.seconds)) {
+        std::cout << "Never reached from here: nothing bakes, or rats outeat any number of buildings there.\n";
+        return 0;
+    }
+    for (size_t i = 0; i < plan.slots.size(); ++i) {
+        std::cout << std::setw(4) << i + 1 << "  " << std::setw(10) << formatDuration(plan.buyAt[i])
+                  << "  " << start.shopItems[plan.slots[i]]->getName() << "\n";
+    }
+    std::cout << "      " << std::setw(10) << formatDuration(plan.seconds) << "  target reached\n\n";
+
+    // Play the plan for real
+    Simulation planned;
+    setUp(planned, savePath);
+    size_t next = 0;
+    double plannedSeconds = play(planned, target, clicks, [&](const Simulation& sim) {
+        if (next >= plan.slots.size() || !sim.shopItems[plan.slots[next]]->canPurchase(sim.game.totalPies)) return -1;
+        return plan.slots[next++];
+    });
+
+    // Greedy: best pies/sec per pie that pays for itself before the target
+    Simulation greedy;
+    setUp(greedy, savePath);
+    double greedySeconds = play(greedy, target, clicks, [&](const Simulation& sim) {
+        double horizon = timeUntilPies(sim, target);
+        int slot = chooseShopItem(sim, BuyOrder::BestPpsPerCost, std::isinf(horizon) ? 1800.0 : horizon);
+        return slot >= 0 && sim.shopItems[slot]->canPurchase(sim.game.totalPies) ? slot : -1;
+    });
+
+    auto played = [](double seconds) { return seconds >= GIVE_UP_SECONDS ? std::string("gave up") : formatDuration(seconds); };
+    std::cout << "Predicted:        " << formatDuration(plan.seconds) << "\n"
+              << "Plan, played:     " << played(plannedSeconds) << "\n"
+              << "Greedy, played:   " << played(greedySeconds) << "\n";
+    return 0;
+}
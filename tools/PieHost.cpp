@@ -0,0 +1,179 @@
+// Hosts many games in one process behind a Unix socket: every connection is
+// one player with its own session, ticked 30 times a second on a fixed pool
+// of shard threads. Clients send game keys as bytes (SPACE, digits, U, R,
+// 0, Y to play again after the goal, N to leave) and '?' for a status line.
+// Build: g++ -std=c++17 -O2 -pthread tools/PieHost.cpp core/GameCore.cpp core/ShopCatalog.cpp core/BigNumber.cpp core/Simulation.cpp core/MessageBoard.cpp core/SessionHost.cpp ui/Input.cpp -o piehost
+// Usage: piehost [socketPath] [threads]    (then, per player: nc -U piehost.sock)
+#include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "../core/SessionHost.h"
+#include "../ui/Input.h"
+
+#ifdef _WIN32
+int main() {
+    std::cerr << "piehost needs Unix sockets\n";
+    return 1;
+}
+#else
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace piegame;
+
+const float FRAME_SECONDS = 1.0f / 30.0f;
+const double REPORT_SECONDS = 10.0;
+
+struct Client {
+    int session;
+    std::string out; // Status lines not yet written
+};
+
+static volatile std::sig_atomic_t quit = 0;
+
+static const char* screenName(SessionScreen screen) {
+    switch (screen) {
+    case SessionScreen::Intro: return "intro";
+    case SessionScreen::Game: return "game";
+    case SessionScreen::PrestigeShop: return "prestige";
+    default: return "won";
+    }
+}
+
+static int listenOn(const char* path) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, path, sizeof(address.sun_path) - 1);
+    unlink(path);
+    if (bind(fd, (sockaddr*)&address, sizeof(address)) < 0 || listen(fd, 128) < 0) {
+        close(fd);
+        return -1;
+    }
+    fcntl(fd, F_SETFL, O_NONBLOCK);
+    return fd;
+}
+
+int main(int argc, char** argv) {
+    const char* path = argc > 1 ? argv[1] : "piehost.sock";
+    unsigned threads = argc > 2 ? (unsigned)atoi(argv[2]) : 0;
+
+    int listener = listenOn(path);
+    if (listener < 0) {
+        std::cerr << "Cannot listen on " << path << "\n";
+        return 1;
+    }
+    std::signal(SIGINT, [](int) { quit = 1; });
+    std::signal(SIGTERM, [](int) { quit = 1; });
+    std::signal(SIGPIPE, SIG_IGN);
+
+    SessionHost host(threads);
+    std::unordered_map<int, Client> clients; // By socket
+    std::vector<pollfd> polled;
+    std::vector<int> leaving;
+    std::cout << "Hosting on " << path << " with " << host.threads() << " shard threads\n";
+
+    using Clock = std::chrono::steady_clock;
+    auto nextFrame = Clock::now();
+    auto lastReport = Clock::now();
+    double tickSeconds = 0.0;
+    long long ticks = 0;
+
+    while (!quit) {
+        // Socket work until the next frame is due
+        polled.clear();
+        polled.push_back({ listener, POLLIN, 0 });
+        for (const auto& c : clients) {
+            polled.push_back({ c.first, (short)(POLLIN | (c.second.out.empty() ? 0 : POLLOUT)), 0 });
+        }
+        int wait = (int)std::chrono::duration_cast<std::chrono::milliseconds>(nextFrame - Clock::now()).count();
+        ::poll(polled.data(), polled.size(), wait > 0 ? wait : 0);
+
+        leaving.clear();
+        for (const pollfd& p : polled) {
+            if (!p.revents) continue;
+            if (p.fd == listener) {
+                int fd;
+                while ((fd = accept(listener, nullptr, nullptr)) >= 0) {
+                    fcntl(fd, F_SETFL, O_NONBLOCK);
+                    clients[fd] = { host.open(), std::string() };
+                }
+                continue;
+            }
+            Client& client = clients[p.fd];
+            if (p.revents & POLLIN) {
+                char bytes[256];
+                ssize_t count = read(p.fd, bytes, sizeof(bytes));
+                if (count <= 0) {
+                    leaving.push_back(p.fd);
+                    continue;
+                }
+                for (ssize_t i = 0; i < count; ++i) {
+                    int key = gameKey((unsigned char)bytes[i]);
+                    if (bytes[i] == '?') {
+                        // As of the last tick: keys sent since are not in it yet
+                        const SessionView& view = *host.view(client.session);
+                        char line[160];
+                        snprintf(line, sizeof(line), "%s pies=%.0f pps=%.0f rats=%d stars=%.1f\n", screenName(view.screen),
+                                 view.pies, view.piesPerSecond, view.rats, view.prestigeStars);
+                        client.out += line;
+                    } else if (key == 'N' && host.view(client.session)->screen == SessionScreen::Won) {
+                        leaving.push_back(p.fd);
+                        break;
+                    } else if (key) {
+                        host.send(client.session, key);
+                    }
+                }
+            }
+            if ((p.revents & POLLOUT) && !client.out.empty()) {
+                ssize_t written = write(p.fd, client.out.data(), client.out.size());
+                if (written > 0) client.out.erase(0, (size_t)written);
+            }
+            if (p.revents & (POLLERR | POLLHUP)) leaving.push_back(p.fd);
+        }
+        for (int fd : leaving) {
+            auto found = clients.find(fd);
+            if (found == clients.end()) continue;
+            host.close(found->second.session);
+            clients.erase(found);
+            close(fd);
+        }
+
+        // Every session's frame, shard by shard
+        auto now = Clock::now();
+        if (now < nextFrame) continue;
+        nextFrame += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(FRAME_SECONDS));
+        if (nextFrame < now) nextFrame = now; // Fell behind: do not try to catch up
+        host.tick(FRAME_SECONDS);
+        tickSeconds += std::chrono::duration<double>(Clock::now() - now).count();
+        ++ticks;
+
+        if (std::chrono::duration<double>(now - lastReport).count() >= REPORT_SECONDS) {
+            double perTick = tickSeconds / ticks;
+            std::cout << host.sessions() << " sessions, " << perTick * 1e3 << " ms/tick";
+            if (host.sessions() > 0) std::cout << " (" << perTick / host.sessions() * 1e9 << " ns per session)";
+            std::cout << std::endl;
+            lastReport = now;
+            tickSeconds = 0.0;
+            ticks = 0;
+        }
+    }
+
+    for (const auto& c : clients) close(c.first);
+    close(listener);
+    unlink(path);
+    return 0;
+}
+#endif
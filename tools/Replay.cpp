@@ -0,0 +1,51 @@
+// Replays a recorded session (piemaker.journal) at full speed and prints the
+// game as it stands at the end, or after a given number of frames.
+// Build: g++ -std=c++17 -O2 tools/Replay.cpp core/GameCore.cpp core/ShopCatalog.cpp core/BigNumber.cpp core/Simulation.cpp core/MessageBoard.cpp core/SaveFile.cpp core/InputJournal.cpp -o replay
+// Usage: replay [journal] [stopAtFrame] [catalog]    (the catalog the game played with, if not the standard one)
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+
+#include "../core/InputJournal.h"
+
+using namespace piegame;
+
+int main(int argc, char** argv) {
+    const char* path = argc > 1 ? argv[1] : "piemaker.journal";
+    uint64_t stopAt = argc > 2 ? (uint64_t)atoll(argv[2]) : UINT64_MAX;
+
+    ShopCatalog catalog = ShopCatalog::standard();
+    std::string error;
+    if (argc > 3 && !catalog.load(argv[3], error)) {
+        std::cerr << (error.empty() ? "Cannot read catalog " + std::string(argv[3]) : error) << "\n";
+        return 1;
+    }
+
+    Journal journal;
+    if (!journal.load(path)) {
+        std::cerr << "Cannot read journal " << path << "\n";
+        return 1;
+    }
+
+    Simulation sim(catalog);
+    Journal::Stats stats;
+    auto start = std::chrono::steady_clock::now();
+    if (!journal.replay(sim, &stats, stopAt)) {
+        std::cerr << "The journal's starting save does not match this build's shop\n";
+        return 1;
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Journal:     " << path << " (" << journal.entryBytes() << " bytes of input"
+              << (journal.startsFromSave() ? ", starts from a save" : "") << ")\n"
+              << "Replayed:    " << stats.frames << " frames, " << stats.actions << " actions, "
+              << stats.runs << " new runs, " << stats.seconds << " s of play in " << ms << " ms\n"
+              << sim.game << "\n"
+              << "Pies/sec: " << sim.game.piesPerSecond << "  Boost%: " << sim.prestigeShop.boostPercent
+              << "  Milk: " << sim.catSystem.milkPurchased << "  Catnip: " << sim.catSystem.catnipLevel << "\n";
+    for (size_t i = 0; i < sim.shopItems.size(); ++i) {
+        const ShopItem& item = *sim.shopItems[i];
+        std::cout << "  [" << i + 1 << "] " << item.getName() << "  cost " << item.getCost() << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,108 @@
+// Plays thousands of complete games per buy/prestige policy on all cores and
+// reports how long each policy takes to reach 1,000,000 pies.
+// Build: g++ -std=c++17 -O2 -pthread tools/Tournament.cpp core/GameCore.cpp core/ShopCatalog.cpp core/BigNumber.cpp core/Simulation.cpp core/MessageBoard.cpp core/FastForward.cpp core/AutoPlayer.cpp -o tournament
+// Usage: tournament [gamesPerPolicy] [threads]
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <algorithm>
+#include <vector>
+
+#include "../core/AutoPlayer.h"
+#include "../core/WorkStealing.h"
+
+using namespace piegame;
+
+struct Policy {
+    const char* name;
+    BuyOrder buyOrder;
+    PrestigeRule prestigeRule;
+};
+
+const Policy POLICIES[] = {
+    { "cheapest, prestige when stalled",   BuyOrder::CheapestFirst,  PrestigeRule::WhenStalled },
+    { "cheapest, prestige when slow",      BuyOrder::CheapestFirst,  PrestigeRule::WhenSlow },
+    { "pps/cost, prestige when stalled",   BuyOrder::BestPpsPerCost, PrestigeRule::WhenStalled },
+    { "pps/cost, prestige when slow",      BuyOrder::BestPpsPerCost, PrestigeRule::WhenSlow },
+    { "pps/cost, never prestige",          BuyOrder::BestPpsPerCost, PrestigeRule::Never },
+};
+const int POLICY_COUNT = sizeof(POLICIES) / sizeof(POLICIES[0]);
+
+// Players differ in how fast they click and how patient they are
+PlayerProfile makeProfile(const Policy& policy, size_t game) {
+    std::mt19937 rng((unsigned)game * 2654435761u + 12345u);
+    PlayerProfile profile;
+    profile.buyOrder = policy.buyOrder;
+    profile.prestigeRule = policy.prestigeRule;
+    profile.clicksPerSecond = std::uniform_real_distribution<double>(3.0, 9.0)(rng);
+    profile.slowSeconds = std::uniform_real_distribution<double>(600.0, 3600.0)(rng);
+    return profile;
+}
+
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t i = (size_t)std::min<double>(sorted.size() - 1, p * (sorted.size() - 1) + 0.5);
+    return sorted[i];
+}
+
+int main(int argc, char** argv) {
+    size_t gamesPerPolicy = argc > 1 ? (size_t)atoll(argv[1]) : 2000;
+    unsigned threads = argc > 2 ? (unsigned)atoi(argv[2]) : 0;
+
+    WorkStealingPool pool(threads);
+    size_t totalGames = gamesPerPolicy * POLICY_COUNT;
+    std::vector<GameResult> results(totalGames);
+
+    auto start = std::chrono::steady_clock::now();
+    pool.run(totalGames, [&](size_t index, unsigned) {
+        // Interleave policies so every worker gets a mix of long and short games
+        const Policy& policy = POLICIES[index % POLICY_COUNT];
+        Simulation sim; // Each game owns its state, shop, cats and prestige shop
+        results[index] = playGame(sim, makeProfile(policy, index / POLICY_COUNT));
+    });
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << totalGames << " games on " << pool.size() << " threads in " << wall << " s ("
+              << (long long)(totalGames / wall) << " games/s)\n\n";
+
+    const double bucketHours[] = { 1, 2, 4, 8, 16, 32 };
+    std::cout << std::left << std::setw(34) << "policy" << std::setw(10) << "finished"
+              << std::setw(12) << "p10" << std::setw(12) << "median" << std::setw(12) << "p90"
+              << std::setw(12) << "max" << "prestiges\n";
+
+    for (int p = 0; p < POLICY_COUNT; ++p) {
+        std::vector<double> times;
+        double prestiges = 0.0;
+        int histogram[7] = { 0 };
+        for (size_t g = p; g < totalGames; g += POLICY_COUNT) {
+            const GameResult& r = results[g];
+            prestiges += r.prestiges;
+            if (!r.reachedGoal) continue;
+            times.push_back(r.seconds);
+            int bucket = 0;
+            while (bucket < 6 && r.seconds / 3600.0 >= bucketHours[bucket]) bucket++;
+            histogram[bucket]++;
+        }
+        std::sort(times.begin(), times.end());
+
+        std::cout << std::setw(34) << POLICIES[p].name
+                  << std::setw(10) << (std::to_string(times.size()) + "/" + std::to_string(gamesPerPolicy));
+        if (times.empty()) {
+            std::cout << std::setw(48) << "never reached the goal";
+        } else {
+            std::cout << std::setw(12) << formatDuration(percentile(times, 0.1))
+                      << std::setw(12) << formatDuration(percentile(times, 0.5))
+                      << std::setw(12) << formatDuration(percentile(times, 0.9))
+                      << std::setw(12) << formatDuration(times.back());
+        }
+        std::cout << std::fixed << std::setprecision(1) << prestiges / gamesPerPolicy << "\n";
+        std::cout.unsetf(std::ios::fixed);
+
+        std::cout << "    time to goal: ";
+        const char* labels[] = { "<1h", "1-2h", "2-4h", "4-8h", "8-16h", "16-32h", ">32h" };
+        for (int b = 0; b < 7; ++b) std::cout << labels[b] << " " << histogram[b] << (b < 6 ? "  " : "\n");
+    }
+    return 0;
+}
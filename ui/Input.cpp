@@ -0,0 +1,156 @@
+#include "Input.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <csignal>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+namespace piegame {
+
+namespace {
+
+#ifdef _WIN32
+DWORD savedMode = 0;
+bool modeSaved = false;
+
+// Virtual-key codes for SPACE, digits and letters are their ASCII codes
+int virtualKeyToGameKey(WORD vk) {
+    bool used = vk == ' ' || (vk >= '0' && vk <= '9') || (vk >= 'A' && vk <= 'Z');
+    return used ? vk : 0;
+}
+#else
+termios savedTerminal;
+bool terminalSaved = false;
+
+void restoreTerminal() {
+    if (terminalSaved) tcsetattr(STDIN_FILENO, TCSANOW, &savedTerminal);
+}
+
+// Ctrl+C still ends the game, but not with the terminal left in raw mode
+void restoreAndRaise(int sig) {
+    restoreTerminal();
+    std::signal(sig, SIG_DFL);
+    std::raise(sig);
+}
+#endif
+
+} // namespace
+
+int gameKey(int c) {
+    if (c >= 'a' && c <= 'z') return c - 'a' + 'A';
+    if (c == ' ' || (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z')) return c;
+    return 0;
+}
+
+// ========================
+// INPUT THREAD
+// ========================
+bool InputThread::start() {
+    if (running) return true;
+#ifdef _WIN32
+    HANDLE in = GetStdHandle(STD_INPUT_HANDLE);
+    if (GetConsoleMode(in, &savedMode)) {
+        modeSaved = true;
+        // Keys only: no line editing, no echo, no mouse or resize events
+        SetConsoleMode(in, savedMode & ~(ENABLE_LINE_INPUT | ENABLE_ECHO_INPUT | ENABLE_MOUSE_INPUT | ENABLE_WINDOW_INPUT));
+    }
+#else
+    // stdin may also be a pipe (scripted input); then there is nothing to set
+    if (tcgetattr(STDIN_FILENO, &savedTerminal) == 0) {
+        termios raw = savedTerminal;
+        raw.c_lflag &= ~(ICANON | ECHO); // Each key as it is typed, not echoed
+        raw.c_cc[VMIN] = 1;
+        raw.c_cc[VTIME] = 0;
+        tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+        terminalSaved = true;
+        std::signal(SIGINT, restoreAndRaise);
+        std::signal(SIGTERM, restoreAndRaise);
+    }
+#endif
+    running = true;
+    reader = std::thread([this] { run(); });
+    return true;
+}
+
+void InputThread::stop() {
+    if (!running) return;
+    running = false;
+    reader.join();
+#ifdef _WIN32
+    if (modeSaved) SetConsoleMode(GetStdHandle(STD_INPUT_HANDLE), savedMode);
+    modeSaved = false;
+#else
+    restoreTerminal();
+    terminalSaved = false;
+#endif
+}
+
+bool InputThread::wait(float seconds) {
+    std::unique_lock<std::mutex> guard(wakeLock);
+    return wake.wait_for(guard, std::chrono::duration<float>(seconds), [&] { return !queue.empty(); });
+}
+
+void InputThread::push(int key) {
+    if (key == 0) return;
+    KeyEvent event;
+    event.key = key;
+    event.when = std::chrono::steady_clock::now();
+    // A full queue means the game is busy (saving, say); hold the key until
+    // there is room rather than drop it
+    while (!queue.push(event)) {
+        if (!running) return;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    readCount.fetch_add(1, std::memory_order_relaxed);
+
+    // Taking the lock orders this against a wait() that just found the queue empty
+    { std::lock_guard<std::mutex> guard(wakeLock); }
+    wake.notify_one();
+}
+
+// The reads below time out every 50 ms so stop() is never kept waiting
+void InputThread::run() {
+#ifdef _WIN32
+    HANDLE in = GetStdHandle(STD_INPUT_HANDLE);
+    bool down[256] = { false };
+    INPUT_RECORD records[32];
+    while (running) {
+        if (WaitForSingleObject(in, 50) != WAIT_OBJECT_0) continue;
+        DWORD count = 0;
+        if (!ReadConsoleInputA(in, records, 32, &count)) break;
+        for (DWORD i = 0; i < count; ++i) {
+            if (records[i].EventType != KEY_EVENT) continue;
+            const KEY_EVENT_RECORD& k = records[i].Event.KeyEvent;
+            WORD vk = k.wVirtualKeyCode & 0xFF;
+            // Held keys repeat key-down events; only the first one is a press
+            if (k.bKeyDown && !down[vk]) push(virtualKeyToGameKey(vk));
+            down[vk] = k.bKeyDown != 0;
+        }
+    }
+#else
+    pollfd in = { STDIN_FILENO, POLLIN, 0 };
+    unsigned char bytes[64];
+    while (running) {
+        if (::poll(&in, 1, 50) <= 0) continue;
+        ssize_t count = read(STDIN_FILENO, bytes, sizeof(bytes));
+        if (count == 0) break; // End of input
+        if (count < 0) continue;
+        for (ssize_t i = 0; i < count; ++i) {
+            // Arrow and function keys arrive as ESC [ ... or ESC O ...
+            // sequences in one read; skip them whole so "ESC [ A" is not an 'A'
+            if (bytes[i] == 0x1b && i + 1 < count && (bytes[i + 1] == '[' || bytes[i + 1] == 'O')) {
+                i += 2;
+                while (i < count && (bytes[i] < 0x40 || bytes[i] > 0x7e)) ++i;
+                continue;
+            }
+            push(gameKey(bytes[i]));
+        }
+    }
+#endif
+}
+
+} // End of namespace piegame
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "../core/SpscQueue.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace piegame {
+
+// ========================
+// KEY EVENTS
+// ========================
+// The keys the game uses: ' ' for SPACE, '0'..'9', and 'A'..'Z' (letters
+// arrive upper case whatever the shift state)
+struct KeyEvent {
+    int key = 0;
+    std::chrono::steady_clock::time_point when; // When the input thread read it
+};
+
+// Maps a typed character to a game key, or 0 if the game has no use for it
+int gameKey(int c);
+
+// ========================
+// INPUT THREAD
+// ========================
+// Reads the keyboard on its own thread and queues every key press, so
+// presses are neither lost between frames nor merged when they come fast.
+// The game drains the queue whenever it likes.
+//
+// Backends: a Win32 console read (a key held down counts once, as the old
+// GetAsyncKeyState polling did), or a termios raw-mode terminal on Linux
+// and other POSIX systems (where a held key auto-repeats like typing).
+class InputThread {
+public:
+    InputThread() = default;
+    ~InputThread() { stop(); }
+    InputThread(const InputThread&) = delete;
+    InputThread& operator=(const InputThread&) = delete;
+
+    // Switches the console to raw key input and starts reading
+    bool start();
+    // Stops reading and puts the console back as it was
+    void stop();
+
+    // Takes the oldest queued key, if any (game thread only)
+    bool poll(KeyEvent& event) { return queue.pop(event); }
+
+    // Sleeps until a key is queued or `seconds` pass; true if a key is waiting
+    bool wait(float seconds);
+
+    // Keys read so far (the input thread's count; for tests and benchmarks)
+    unsigned long long keysRead() const { return readCount.load(std::memory_order_relaxed); }
+
+private:
+    static const size_t QUEUE_SIZE = 1024;
+
+    SpscQueue<KeyEvent, QUEUE_SIZE> queue;
+    std::thread reader;
+    std::atomic<bool> running{ false };
+    std::atomic<unsigned long long> readCount{ 0 };
+    std::mutex wakeLock; // Only for sleeping in wait(); the queue needs no lock
+    std::condition_variable wake;
+
+    void run();
+    void push(int key);
+};
+
+} // End of namespace piegame
@@ -0,0 +1,421 @@
+#include "Render.h"
+#include "../core/FastForward.h" // "Goal in" estimate
+#include "../core/PrestigeCatalog.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace piegame {
+
+// ========================
+// ASCII ART
+// ========================
+// Various ASCII art assets for the game
+std::vector<std::string> pieSteam1 = {
+    "             (",
+    "              )"
+};
+std::vector<std::string> pieSteam2 = {
+    "            ~(",
+    "           ~ )"
+};
+
+std::vector<std::string> pieIdle1 = {
+    "         __..---..__",
+    "     ,-='  /  |  \\  `=-.",
+    "    :--..___________..--;",
+    "     \\.,_____________,./"
+};
+std::vector<std::string> pieIdle2 = pieIdle1;
+
+std::vector<std::string> piePressed = {
+    "         __..---..__",
+    "     ,-='  /  |  \\  `=-.",
+    "    :--..___________..--;",
+    "     \\.,_O_O_O_O_O___,./"
+};
+
+std::vector<std::string> celebrationPie = {
+    "    .-~~~~~-.    ",
+    "   /         \\   ",
+    "  |   *   *   |  ",
+    "  |  =======  |  ",
+    "   \\ ~~~~~~~ /   ",
+    "    `-------`    ",
+    "     \\     /     ",
+    "      \\   /      ",
+    "       \\ /       ",
+    "        V        "
+};
+
+std::vector<std::vector<std::string>> fireworksFrames = {
+    {
+        "   *  .  *  .  *   ",
+        " .    *    *    .  ",
+        "   .  *  *  *      ",
+        " *   .     *   .   ",
+        "      *  .  *      "
+    },
+    {
+        "      .  *  .      ",
+        " *   .     *   .   ",
+        "   *  .  *  .  *   ",
+        " .    *    *    .  ",
+        "   .  *  *  *      "
+    },
+    {
+        " .    *    *    .  ",
+        "   .  *  *  *      ",
+        "      *  .  *      ",
+        "   *  .  *  .  *   ",
+        " *   .     *   .   "
+    }
+};
+
+std::vector<std::string> ratArt = {
+    "                        .--.",
+    "               (\\./)     \\.......-",
+    "              >' '<  (__.'\"\"\"\"BP",
+    "              \" ` \" \""
+};
+
+namespace {
+
+// Formats a number straight into the screen, with no string in between
+void printNumber(ScreenBuffer& screen, const BigNumber& value, NumberStyle style = NumberStyle::Commas) {
+    char digits[NUMBER_TEXT_MAX];
+    screen.printChars(digits, formatNumber(digits, value, style));
+}
+
+} // namespace
+
+// ========================
+// TITLE CARD
+// ========================
+void renderTitle(ScreenBuffer& screen) {
+    screen.beginFrame();
+    screen.print("=== PIE MAKER IDLE ===\n\n");
+    screen.print("Your goal: Bake ONE MILLION PIES!\n\n");
+    screen.print("Start by pressing SPACE to bake your first pie.\n\n", COLOR_YELLOW);
+}
+
+// ========================
+// INTRO RENDER FUNCTION
+// ========================
+// Renders the intro/tutorial screen
+void renderIntro(ScreenBuffer& screen, const Simulation& sim) {
+    const GameState& game = sim.game;
+    const IntroState& intro = sim.intro;
+
+    screen.beginFrame();
+    screen.print("=== PIE MAKER IDLE ===\n");
+    screen.print("Goal: Bake 1,000,000 pies!\n");
+    screen.print("Pies: ");
+    printNumber(screen, game.totalPies, NumberStyle::Plain);
+    screen.print("\n");
+    screen.print("\n");
+    screen.print("[SPACE] Bake a pie!\n");
+    screen.print("\n");
+    if (intro.unlockAvailable) {
+        screen.print("[U] Unlock buildings (Cost: 50 pies)\n");
+        screen.print("\n");
+    }
+    for (int line = 0; line < sim.messages.lineCount(); ++line) {
+        screen.print(sim.messages.lineText(line) + "\n", COLOR_YELLOW);
+    }
+}
+
+// ========================
+// PRESTIGE SHOP RENDER
+// ========================
+// Renders the prestige shop screen
+void renderPrestigeShop(ScreenBuffer& screen, const Simulation& sim) {
+    const GameState& game = sim.game;
+    const PrestigeShop& prestigeShop = sim.prestigeShop;
+
+    screen.beginFrame();
+    screen.print("=== PRESTIGE SHOP ===\n");
+    screen.print("Prestige Stars: " + std::to_string((int)game.prestigeStars) + "\n\n");
+
+    const CatSystem& cats = sim.catSystem;
+    for (int i = 0; i < PrestigeCatalog::size; ++i) {
+        if (prestigeUpgradeVisible(i, prestigeShop, cats)) {
+            screen.print("[" + std::to_string(i + 1) + "] " + prestigeUpgradeName(i) +
+                         " (" + std::to_string(prestigeUpgradeCost(i, prestigeShop, cats)) + " stars)\n");
+            screen.print("   " + prestigeUpgradeDescription(i, prestigeShop, cats) + "\n\n");
+        }
+    }
+
+    screen.print("[0] Return to game\n");
+}
+
+// ========================
+// SHOP PAGES
+// ========================
+int shopSlotForKey(const MainScreenWidgets& widgets, const Simulation& sim, int key) {
+    if (key < '1' || key >= '1' + SHOP_PAGE_SIZE) return -1;
+    size_t at = (size_t)(widgets.shopPage * SHOP_PAGE_SIZE + (key - '1'));
+    const std::vector<int>& listed = sim.listedItems();
+    return at < listed.size() ? listed[at] : -1;
+}
+
+void turnShopPage(MainScreenWidgets& widgets, const Simulation& sim, int pages) {
+    int last = std::max(0, ((int)sim.listedItems().size() - 1) / SHOP_PAGE_SIZE);
+    widgets.shopPage = std::min(std::max(widgets.shopPage + pages, 0), last);
+}
+
+void cycleBuyAmount(MainScreenWidgets& widgets) {
+    switch (widgets.buyAmount) {
+    case 1: widgets.buyAmount = 10; break;
+    case 10: widgets.buyAmount = 100; break;
+    case 100: widgets.buyAmount = BUY_MAX; break;
+    default: widgets.buyAmount = 1; break;
+    }
+}
+
+// ========================
+// CELEBRATION
+// ========================
+void renderCelebration(ScreenBuffer& screen, int frameIndex) {
+    const auto& fw = fireworksFrames[frameIndex % fireworksFrames.size()];
+    int fireworksWidth = fw[0].size();
+    int pieWidth = celebrationPie[0].size();
+    int totalWidth = fireworksWidth + 3 + pieWidth + 3 + fireworksWidth;
+
+    std::string congrats = "CONGRATULATIONS!";
+    std::string baked = "You baked 1,000,000 pies!";
+
+    screen.beginFrame();
+    screen.print("\n\n");
+
+    int leftPad = (totalWidth - (int)congrats.size()) / 2;
+    screen.print(std::string(leftPad, ' ') + congrats + "\n");
+    leftPad = (totalWidth - (int)baked.size()) / 2;
+    screen.print(std::string(leftPad, ' ') + baked + "\n\n");
+
+    for (size_t i = 0; i < celebrationPie.size(); ++i) {
+        uint8_t color = COLOR_DEFAULT;
+        switch (i % 5) {
+            case 0: color = COLOR_RED; break;
+            case 1: color = COLOR_YELLOW; break;
+            case 2: color = COLOR_GREEN; break;
+            case 3: color = COLOR_CYAN; break;
+            case 4: color = COLOR_MAGENTA; break;
+        }
+        screen.print(fw[i % fw.size()], color);
+        screen.print("   " + celebrationPie[i] + "   ");
+        screen.print(fw[i % fw.size()] + "\n", color);
+    }
+
+    screen.print("\nWould you like to play again? (Y/N): ");
+}
+
+// ========================
+// RENDER FRAME
+// ========================
+// Renders the main game screen each frame. Each widget re-formats only when
+// its values change, and if none did the screen keeps the previous frame.
+void renderFrame(ScreenBuffer& screen, MainScreenWidgets& w, const Simulation& sim, const PieAnimation& anim,
+                 const FrameProfiler* timings) {
+    const GameState& game = sim.game;
+    const CatSystem& catSystem = sim.catSystem;
+    const PrestigeShop& prestigeShop = sim.prestigeShop;
+    const ShopList& shopItems = sim.shopItems;
+    const MessageBoard& messages = sim.messages;
+    const RatSystem& rats = game.ratSystem;
+    unsigned long long& clock = w.clock;
+
+    // These two change nearly every frame: rewritten in place, no allocation
+    w.pieCounter.rewrite(game.totalPies, clock, [&](std::string& text) {
+        text += "Pies: ";
+        appendNumber(text, game.totalPies);
+        text += '\n';
+    });
+
+    w.perSecond.rewrite({ game.piesPerSecond, rats.getRatsEating(), rats.getTotalRats() > 0 }, clock, [&](std::string& text) {
+        text += "Per second: ";
+        appendNumber(text, game.piesPerSecond, NumberStyle::Plain);
+        if (rats.getTotalRats() > 0) {
+            text += " (-";
+            appendNumber(text, rats.getRatsEating(), NumberStyle::Plain);
+            text += ')';
+        }
+        text += '\n';
+    });
+
+    // Idle time to the goal at the current rate (no frames are stepped for this)
+    w.goalIn.update({ game.totalPies, game.piesPerSecond, catSystem.milkPurchased, catSystem.catnipLevel }, clock, [&] {
+        if (game.piesPerSecond <= 0) return std::string();
+        double toGoal = timeUntilPies(sim, GOAL_PIES);
+        return "Goal in: " + (std::isinf(toGoal) ? std::string("never, the rats keep up!") : formatDuration(toGoal)) + "\n";
+    });
+
+    // Prestige stars and upgrades status
+    w.stats.update({ (int)game.prestigeStars, prestigeShop.boostPercent, catSystem.milkPurchased,
+                     catSystem.catnipLevel, prestigeShop.hasGoldenSword }, clock, [&] {
+        std::string text = "Prestige Stars: " + std::to_string((int)game.prestigeStars) + "\n";
+        if (prestigeShop.boostPercent > 0) {
+            text += "Boost: " + std::to_string(prestigeShop.boostPercent) + "%\n";
+        }
+        if (catSystem.milkPurchased > 0) {
+            text += "Milk: " + std::to_string(catSystem.milkPurchased) + "\n";
+        }
+        if (catSystem.getTotalCats() > 0 || catSystem.milkPurchased > 0) {
+            text += "Cats: " + std::to_string(catSystem.getTotalCats()) + "\n";
+        }
+        if (catSystem.catnipLevel > 0) {
+            text += "Catnip: " + std::to_string(catSystem.catnipLevel) + "\n";
+        }
+        if (prestigeShop.hasGoldenSword) {
+            text += "Golden Sword: OWNED\n";
+        }
+        return text;
+    });
+
+    w.ratLine.update({ rats.getTotalRats(), (int)rats.getRatsEatingSingle() }, clock, [&] {
+        if (rats.getTotalRats() <= 0) return std::string("\n");
+        return "Rats: " + std::to_string(rats.getTotalRats()) +
+            (rats.getRatsEatingSingle() > 0 ? " (Each eating " + std::to_string((int)rats.getRatsEatingSingle()) + " pies/sec)" : "") + "\n\n";
+    });
+
+    BigNumber piesForDisplay = std::max(game.piesBakedThisRun, BigNumber(1000));
+    w.resetLine.update({ game.prestigeUnlocked, piesForDisplay }, clock, [&] {
+        if (!game.prestigeUnlocked) return std::string();
+        return "[R] RESET for " + std::to_string(sqrt((float)piesForDisplay.toDouble() / 1000.0f)) + " prestige stars!\n\n";
+    });
+
+    // Shop items: one page of the listed ones, a blank line before the
+    // first upgrade that follows a building. Buildings are priced for the
+    // buy amount; on max, for as many as the pies pay for (at least one).
+    const std::vector<int>& listed = sim.listedItems();
+    turnShopPage(w, sim, 0);
+    int pages = std::max(1, ((int)listed.size() + SHOP_PAGE_SIZE - 1) / SHOP_PAGE_SIZE);
+    w.shopPageLine.update({ w.shopPage, pages, w.buyAmount, w.autoBuying }, clock, [&] {
+        std::string text = w.buyAmount == BUY_MAX ? "[B] Buy max" : "[B] Buy x" + std::to_string(w.buyAmount);
+        text += w.autoBuying ? "   [A] Autobuy on" : "   [A] Autobuy off";
+        if (pages > 1) {
+            text += "   Shop page " + std::to_string(w.shopPage + 1) + "/" + std::to_string(pages) + " ([P]/[N])";
+        }
+        return text + "\n";
+    });
+    if (w.shopRows.size() != (size_t)SHOP_PAGE_SIZE) {
+        w.shopRows.assign(SHOP_PAGE_SIZE, {});
+        clock++;
+    }
+    const ShopCatalog& catalog = sim.catalog();
+    for (int row = 0; row < SHOP_PAGE_SIZE; ++row) {
+        size_t at = (size_t)(w.shopPage * SHOP_PAGE_SIZE + row);
+        if (at >= listed.size()) {
+            w.shopRows[row].update({ -1, false, 0, BigNumber(), BigNumber() }, clock, [] { return std::string(); });
+            continue;
+        }
+        int slot = listed[at];
+        const ShopItem& item = *shopItems[slot];
+        bool gap = row > 0 && catalog[slot].kind == ShopKind::Upgrade &&
+                   catalog[listed[at - 1]].kind == ShopKind::Building;
+        int units = 1;
+        BigNumber cost = item.getCost();
+        if (w.buyAmount != 1 && catalog[slot].kind == ShopKind::Building) {
+            const Building& building = static_cast<const Building&>(item);
+            units = w.buyAmount == BUY_MAX ? std::max(1, building.getAffordable(game.totalPies)) : w.buyAmount;
+            cost = building.getCost(units);
+        }
+        w.shopRows[row].update({ slot, gap, units, cost, item.getPiesPerSecond() }, clock, [&] {
+            std::string text = gap ? "\n[" : "[";
+            text += std::to_string(row + 1) + "] " + item.getName();
+            if (units > 1) text += " x" + std::to_string(units);
+            text += " (";
+            appendNumber(text, cost, NumberStyle::Plain);
+            return text + " pies) - " + item.getDescription() + "\n";
+        });
+    }
+
+    // Steam, pie, rats and artist tag
+    int ratCount = rats.getTotalRats();
+    bool catsShown = catSystem.getTotalCats() > 0;
+    w.pieArt.update({ anim.idleFrame, anim.showPressedPie, ratCount, catsShown }, clock, [&] {
+        const std::vector<std::string>& steamToShow = (anim.idleFrame == 0) ? pieSteam1 : pieSteam2;
+        const std::vector<std::string>& pieToShow = anim.showPressedPie ? piePressed : pieIdle1;
+        std::string text;
+        for (const auto& line : steamToShow) text += line + "\n";
+
+        if (ratCount > 0 || catsShown) {
+            const int gap = 2; // Space between elements
+            const int pieWidth = pieToShow.empty() ? 0 : pieToShow[0].size();
+            const int ratWidth = ratArt.empty() ? 0 : ratArt[0].size();
+            int maxLines = std::max(pieToShow.size(), ratArt.size());
+
+            // Draw combined ASCII art (pie | rat)
+            for (int i = 0; i < maxLines; ++i) {
+                std::string line = i < pieToShow.size() ? pieToShow[i] : std::string(pieWidth, ' ');
+                // Rat (column always reserved if rats exist)
+                if (ratCount > 0) {
+                    line += std::string(gap, ' ');
+                    line += i < ratArt.size() ? ratArt[i] : std::string(ratWidth, ' ');
+                }
+                text += line + "\n";
+            }
+
+            // The rats message under the rat art
+            if (ratCount > 0) {
+                std::string ratMsg = std::string(12, ' ') + std::to_string(ratCount) + " rats are stealing your pies!";
+                text += std::string(pieWidth + gap, ' ') + ratMsg + "\n";
+            }
+        } else {
+            for (const auto& line : pieToShow) text += line + "\n";
+        }
+        text += "     Riitta Rasimus\n";
+        return text;
+    });
+
+    // Frame timing overlay: new numbers with every frame profiled
+    w.timings.update(timings ? timings->frames() + 1 : 0, clock, [&] {
+        return timings ? "\n" + timings->summary() : std::string();
+    });
+
+    // Messages last: they are the bottom of the screen, and the one part
+    // that can be redrawn on its own
+    unsigned long long beforeMessages = clock;
+    w.messages.update(messages.version(), clock, [&] {
+        std::string text;
+        if (messages.active()) text += "\n";
+        for (int line = 0; line < messages.lineCount(); ++line) text += messages.lineText(line) + "\n";
+        return text;
+    });
+
+    // Nothing changed and the screen still shows our last frame: keep it
+    bool onScreen = screen.frameCount() == w.drawnFrame;
+    if (w.clock == w.drawnAt && onScreen) return;
+
+    // Only the messages changed (one ran out, a purchase came in): redraw their rows
+    if (beforeMessages == w.drawnAt && onScreen) {
+        screen.beginRegion(w.messagesRow);
+        screen.print(w.messages.getText(), COLOR_YELLOW);
+        w.drawnAt = w.clock;
+        w.drawnFrame = screen.frameCount();
+        return;
+    }
+
+    screen.beginFrame();
+    screen.print("=== PIE MAKER IDLE ===\n");
+    screen.print("Goal: Bake 1,000,000 pies!\n");
+    screen.print(w.pieCounter.getText());
+    screen.print(w.perSecond.getText());
+    screen.print(w.goalIn.getText());
+    screen.print(w.stats.getText());
+    screen.print(w.ratLine.getText());
+    screen.print("[SPACE] Bake a pie!\n\n");
+    screen.print(w.resetLine.getText());
+    screen.print(w.shopPageLine.getText());
+    for (const auto& row : w.shopRows) screen.print(row.getText());
+    screen.print("\n");
+    screen.print(w.pieArt.getText());
+    screen.print(w.timings.getText(), COLOR_CYAN);
+    w.messagesRow = screen.cursorRow();
+    screen.print(w.messages.getText(), COLOR_YELLOW);
+
+    w.drawnAt = w.clock;
+    w.drawnFrame = screen.frameCount();
+}
+
+} // End of namespace piegame
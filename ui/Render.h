@@ -0,0 +1,85 @@
+#pragma once
+
+#include "ScreenBuffer.h"
+#include "Widgets.h"
+#include "../core/Simulation.h"
+
+namespace piegame {
+
+const int CONSOLE_WIDTH = 80;
+const int CONSOLE_HEIGHT = 50;
+
+// ========================
+// PIE ANIMATION
+// ========================
+// Front-end only state: the pressed-pie flash and the idle steam animation
+struct PieAnimation {
+    static constexpr float PRESS_SECONDS = 5.0f / 30.0f; // Five frames at 30 FPS
+    static constexpr float IDLE_SECONDS = 0.4f;          // Steam frame length
+
+    bool showPressedPie = false; // Should the pressed pie art be shown?
+    float pieAnimTimer = 0.0f;   // Seconds left of the pie press animation
+    int idleFrame = 0;           // Which idle frame to show
+    float idleTimer = 0.0f;      // Timer for idle animation
+
+    // SPACE was pressed
+    void press() {
+        showPressedPie = true;
+        pieAnimTimer = PRESS_SECONDS;
+    }
+    // Advances the animations by deltaTime seconds
+    void update(float deltaTime) {
+        pieAnimTimer -= deltaTime;
+        if (pieAnimTimer <= 0.0f) {
+            showPressedPie = false;
+        }
+        idleTimer += deltaTime;
+        if (idleTimer >= IDLE_SECONDS) {
+            idleFrame = 1 - idleFrame;
+            idleTimer = 0.0f;
+        }
+    }
+    // Seconds until the pie art changes by itself
+    float secondsUntilChange() const {
+        float next = IDLE_SECONDS - idleTimer;
+        if (showPressedPie && pieAnimTimer < next) next = pieAnimTimer;
+        return next > 0.0f ? next : 0.0f;
+    }
+};
+
+// ========================
+// SCREENS
+// ========================
+// Each draws one complete frame into the screen's back buffer; the caller
+// sends screen.present() to the terminal.
+
+// "Press SPACE to start" title card
+void renderTitle(ScreenBuffer& screen);
+
+// Intro/tutorial screen
+void renderIntro(ScreenBuffer& screen, const Simulation& sim);
+
+// Prestige shop screen
+void renderPrestigeShop(ScreenBuffer& screen, const Simulation& sim);
+
+// Main game screen. The widgets keep the formatted parts between frames;
+// keep one MainScreenWidgets per screen and pass it every frame. With
+// timings, the per-phase frame times are shown under the pie art.
+void renderFrame(ScreenBuffer& screen, MainScreenWidgets& widgets, const Simulation& sim, const PieAnimation& anim,
+                 const FrameProfiler* timings = nullptr);
+
+// Shop slot that key [1]-[9] buys on the shop page the main screen shows,
+// or -1 if that row is empty
+int shopSlotForKey(const MainScreenWidgets& widgets, const Simulation& sim, int key);
+
+// Turns the main screen's shop page by `pages` (negative: back), staying
+// within the listed items
+void turnShopPage(MainScreenWidgets& widgets, const Simulation& sim, int pages);
+
+// Moves the buy amount [B] picks on to the next of x1, x10, x100 and max
+void cycleBuyAmount(MainScreenWidgets& widgets);
+
+// Fireworks and the play-again prompt; frameIndex picks the fireworks frame
+void renderCelebration(ScreenBuffer& screen, int frameIndex);
+
+} // End of namespace piegame
@@ -0,0 +1,141 @@
+#include "ScreenBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace piegame {
+
+namespace {
+
+const int MAX_RUN_GAP = 4; // Reprint up to this many unchanged cells rather than move the cursor
+
+// ANSI "select graphic rendition" for a console color
+void appendColor(std::string& out, uint8_t color) {
+    if (color == COLOR_DEFAULT) {
+        out += "\x1b[0m";
+        return;
+    }
+    // Console bits are blue/green/red, ANSI's are red/green/blue
+    int ansi = ((color & 4) ? 1 : 0) | (color & 2) | ((color & 1) ? 4 : 0);
+    out += "\x1b[";
+    out += std::to_string(((color & 8) ? 90 : 30) + ansi);
+    out += 'm';
+}
+
+void appendCursorMove(std::string& out, int row, int col) {
+    out += "\x1b[";
+    out += std::to_string(row + 1);
+    out += ';';
+    out += std::to_string(col + 1);
+    out += 'H';
+}
+
+} // namespace
+
+ScreenBuffer::ScreenBuffer(int width, int height)
+    : width(width), height(height), back(width * height), front(width * height), blank(width * height) {}
+
+void ScreenBuffer::beginFrame() {
+    std::copy(blank.begin(), blank.end(), back.begin()); // A plain memmove
+    row = 0;
+    col = 0;
+    firstRow = 0;
+    drawn = true;
+    frames++;
+}
+
+void ScreenBuffer::beginRegion(int fromRow) {
+    fromRow = std::max(0, std::min(fromRow, height));
+    std::copy(blank.begin() + fromRow * width, blank.end(), back.begin() + fromRow * width);
+    row = fromRow;
+    col = 0;
+    firstRow = fromRow;
+    drawn = true;
+    frames++;
+}
+
+void ScreenBuffer::print(const std::string& text, uint8_t color) {
+    printChars(text.data(), text.size(), color);
+}
+
+void ScreenBuffer::printChars(const char* text, size_t length, uint8_t color) {
+    drawn = true;
+    for (size_t i = 0; i < length; ++i) {
+        char ch = text[i];
+        if (ch == '\n') {
+            row++;
+            col = 0;
+            continue;
+        }
+        if (row < height && col < width) {
+            Cell& cell = back[row * width + col];
+            cell.ch = ch;
+            cell.color = color;
+        }
+        col++;
+    }
+}
+
+void ScreenBuffer::printAt(int atRow, int atCol, const std::string& text, uint8_t color) {
+    if (atRow < 0 || atRow >= height) return;
+    drawn = true;
+    for (size_t i = 0; i < text.size(); ++i) {
+        int c = atCol + (int)i;
+        if (c < 0 || c >= width) continue;
+        Cell& cell = back[atRow * width + c];
+        cell.ch = text[i];
+        cell.color = color;
+    }
+}
+
+void ScreenBuffer::invalidate() {
+    frontValid = false;
+}
+
+const std::string& ScreenBuffer::present() {
+    output.clear();
+    if (!drawn && frontValid) return output; // Same frame as last time
+    drawn = false;
+    int from = firstRow;
+    firstRow = 0;
+    if (!frontValid) {
+        // Start from a cleared terminal; blank cells then need no output
+        output += "\x1b[0m\x1b[2J";
+        terminalColor = COLOR_DEFAULT;
+        for (Cell& cell : front) cell = Cell();
+        frontValid = true;
+        from = 0;
+    }
+
+    for (int r = from; r < height; ++r) {
+        // Most rows are unchanged; a Cell is two plain bytes, so compare whole rows first
+        if (std::memcmp(&back[r * width], &front[r * width], width * sizeof(Cell)) == 0) continue;
+        int cursorCol = -1; // Where the terminal cursor is on this row (-1: elsewhere)
+        for (int c = 0; c < width; ++c) {
+            int i = r * width + c;
+            if (!(back[i] != front[i])) continue;
+
+            // Close a small gap by reprinting it, if that needs no color change
+            bool bridge = cursorCol >= 0 && c - cursorCol <= MAX_RUN_GAP;
+            for (int k = cursorCol; bridge && k < c; ++k) {
+                bridge = front[r * width + k].color == terminalColor;
+            }
+            if (bridge) {
+                for (int k = cursorCol; k < c; ++k) output += front[r * width + k].ch;
+            } else if (cursorCol != c) {
+                appendCursorMove(output, r, c);
+            }
+
+            if (back[i].color != terminalColor) {
+                appendColor(output, back[i].color);
+                terminalColor = back[i].color;
+            }
+            output += back[i].ch;
+            front[i] = back[i];
+            cursorCol = c + 1;
+        }
+    }
+    return output;
+}
+
+} // End of namespace piegame
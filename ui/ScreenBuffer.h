@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace piegame {
+
+// Console colors, same numbers as the Windows console attributes the game
+// always used (bit 0 blue, bit 1 green, bit 2 red, bit 3 bright)
+enum ConsoleColor : uint8_t {
+    COLOR_DEFAULT = 7,
+    COLOR_GREEN = 10,
+    COLOR_CYAN = 11,
+    COLOR_RED = 12,
+    COLOR_MAGENTA = 13,
+    COLOR_YELLOW = 14
+};
+
+// ========================
+// SCREEN BUFFER
+// ========================
+// A double-buffered grid of character + color cells. Each frame is drawn
+// into the back grid from scratch (print() works like writing to a console:
+// '\n' moves to the start of the next row). present() compares it with what
+// the terminal already shows and returns ANSI cursor/color sequences for the
+// changed cells only, ready to go out in a single write.
+// Nothing here touches the console itself, so it runs anywhere.
+class ScreenBuffer {
+public:
+    ScreenBuffer(int width, int height);
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+    // Starts a new frame: blank back grid, cursor at the top left. A frame
+    // that is not redrawn keeps the previous one, and present() is free.
+    void beginFrame();
+
+    // Starts a frame that keeps the previous one above `fromRow` and
+    // redraws only from there down (cursor at its start): present() then
+    // looks at those rows alone. The back grid must still hold the
+    // previous frame, i.e. nothing was drawn since it was presented.
+    void beginRegion(int fromRow);
+
+    // Number of frames begun so far (tells a cached screen whether it is
+    // still the one on display)
+    unsigned long long frameCount() const { return frames; }
+
+    // Writes text at the cursor; '\n' goes to the next row. Text past the
+    // right or bottom edge is dropped.
+    void print(const std::string& text, uint8_t color = COLOR_DEFAULT);
+    // Same for a char buffer that is not 0-terminated (see formatNumber)
+    void printChars(const char* text, size_t length, uint8_t color = COLOR_DEFAULT);
+
+    // Writes text at a given position without moving the cursor
+    void printAt(int row, int col, const std::string& text, uint8_t color = COLOR_DEFAULT);
+
+    int cursorRow() const { return row; }
+
+    // Forgets what the terminal shows, so the next present() clears it and
+    // repaints everything (for a manual clear or after other output)
+    void invalidate();
+
+    // Returns the bytes that bring the terminal from the last presented
+    // frame to this one, and makes this frame the presented one
+    const std::string& present();
+
+    // Size of the last present() output, in bytes
+    size_t lastFrameBytes() const { return output.size(); }
+
+private:
+    struct Cell {
+        char ch = ' ';
+        uint8_t color = COLOR_DEFAULT;
+        bool operator!=(const Cell& other) const { return ch != other.ch || color != other.color; }
+    };
+
+    int width;
+    int height;
+    int row = 0;
+    int col = 0;
+    std::vector<Cell> back;  // Frame being drawn
+    std::vector<Cell> front; // What the terminal shows
+    std::vector<Cell> blank; // An empty screen, copied over back to start a frame
+    bool frontValid = false;
+    bool drawn = false;      // Has the back grid changed since the last present()?
+    int firstRow = 0;        // Rows above this one are as last presented
+    unsigned long long frames = 0;
+    int terminalColor = -1;  // Color the terminal is currently set to (-1: unknown)
+    std::string output;
+};
+
+} // End of namespace piegame
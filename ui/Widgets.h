@@ -0,0 +1,86 @@
+#pragma once
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "../core/BigNumber.h"
+
+namespace piegame {
+
+// ========================
+// RETAINED WIDGETS
+// ========================
+// A piece of screen text that is only re-formatted when the values it shows
+// change. The caller passes those values as a key each frame; format() runs
+// only if the key differs from last time.
+//
+// Every change takes a stamp from a shared clock, so "has anything on this
+// screen changed since I drew it?" is a single comparison with clock.
+template <typename Key>
+class Widget {
+public:
+    template <typename Format>
+    const std::string& update(const Key& key, unsigned long long& clock, Format format) {
+        if (!valid || !(key == lastKey)) {
+            lastKey = key;
+            text = format();
+            valid = true;
+            version = ++clock;
+        }
+        return text;
+    }
+
+    // Same, but write(text) refills the kept string in place, so a widget
+    // that changes every frame reuses its storage instead of allocating
+    template <typename Write>
+    const std::string& rewrite(const Key& key, unsigned long long& clock, Write write) {
+        if (!valid || !(key == lastKey)) {
+            lastKey = key;
+            text.clear();
+            write(text);
+            valid = true;
+            version = ++clock;
+        }
+        return text;
+    }
+
+    const std::string& getText() const { return text; }
+    unsigned long long getVersion() const { return version; } // Clock value of the last change
+
+private:
+    Key lastKey{};
+    bool valid = false;
+    std::string text;
+    unsigned long long version = 0;
+};
+
+// ========================
+// MAIN SCREEN WIDGETS
+// ========================
+const int SHOP_PAGE_SIZE = 9; // Shop rows per page, on keys [1]-[9]
+
+// The parts of the main game screen, each with the values that decide its text
+struct MainScreenWidgets {
+    unsigned long long clock = 0;      // Bumped by every widget change
+    unsigned long long drawnAt = 0;    // clock when the screen was last drawn
+    unsigned long long drawnFrame = 0; // ScreenBuffer frame that drawing produced
+
+    Widget<BigNumber> pieCounter;                       // totalPies
+    Widget<std::tuple<BigNumber, BigNumber, bool>> perSecond;  // pps, rats eating, rats visible
+    Widget<std::tuple<BigNumber, BigNumber, int, int>> goalIn; // pies, pps, milk, catnip
+    Widget<std::tuple<int, int, int, int, bool>> stats; // stars, boost, milk, catnip, sword
+    Widget<std::tuple<int, int>> ratLine;               // rats, pies each rat eats
+    Widget<std::tuple<bool, BigNumber>> resetLine;      // unlocked, pies baked this run
+    int shopPage = 0;                                   // Page of listed shop items shown
+    int buyAmount = 1;                                  // Buildings per key press: 1, 10, 100 or BUY_MAX
+    bool autoBuying = false;                            // Autobuyer switched on with [A]
+    Widget<std::tuple<int, int, int, bool>> shopPageLine; // page, pages, buy amount, autobuying
+    std::vector<Widget<std::tuple<int, bool, int, BigNumber, BigNumber>>> shopRows; // slot (-1: none), gap above, units, cost, pies/sec
+    Widget<std::tuple<int, bool, int, bool>> pieArt;    // idle frame, pressed, rats, cats
+    Widget<uint64_t> timings;                           // Frames profiled (0 when the overlay is off)
+    Widget<uint64_t> messages;                          // MessageBoard::version()
+    int messagesRow = 0;                                // Screen row the messages start on
+};
+
+} // End of namespace piegame